@@ -0,0 +1,48 @@
+#include "async_similarity_transform.hpp"
+
+template<typename T>
+std::future<int64_t>
+async_similarity_transform(sycl::queue q,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           const solver_options_t<T> opts,
+                           uint* const iter_count)
+{
+  // implicit formulation never writes to input matrix, so nothing needs to
+  // be copied before returning control to caller
+  return std::async(std::launch::async, [=]() mutable {
+    return implicit_similarity_transform<T>(q,
+                                            mat,
+                                            eigen_val,
+                                            eigen_vec,
+                                            nullptr,
+                                            nullptr,
+                                            dim,
+                                            wg_size,
+                                            opts,
+                                            iter_count);
+  });
+}
+
+template std::future<int64_t>
+async_similarity_transform<float>(sycl::queue q,
+                                  const float* mat,
+                                  float* const eigen_val,
+                                  float* const eigen_vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  const solver_options_t<float> opts,
+                                  uint* const iter_count);
+
+template std::future<int64_t>
+async_similarity_transform<double>(sycl::queue q,
+                                   const double* mat,
+                                   double* const eigen_val,
+                                   double* const eigen_vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   const solver_options_t<double> opts,
+                                   uint* const iter_count);
@@ -0,0 +1,292 @@
+#include "autotune.hpp"
+#include "small_similarity_transform.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// tuned configurations are memoised in process, so that cache file is only
+// read once, on first lookup
+static std::mutex tune_lock;
+static std::map<std::string, tuned_config> tune_table;
+static bool tune_table_loaded = false;
+
+static std::string
+tune_cache_path()
+{
+  const char* path = std::getenv(TUNE_CACHE_ENV);
+  return path != nullptr ? std::string{ path }
+                         : std::string{ DEFAULT_TUNE_CACHE };
+}
+
+// ceil(log2(dim))
+static uint
+dim_bucket(const uint dim)
+{
+  uint b = 0;
+  while ((1ul << b) < dim) {
+    b++;
+  }
+  return b;
+}
+
+template<typename T>
+static std::string
+tune_key(const sycl::device& d, const uint dim)
+{
+  // device names may have spaces in them, so tab separated
+  return d.get_info<sycl::info::device::name>() + "\t" +
+         d.get_info<sycl::info::device::driver_version>() + "\t" +
+         std::to_string(sizeof(T) * 8) + "\t" + std::to_string(dim_bucket(dim));
+}
+
+// each line of cache file looks like
+//
+// <device name>\t<driver version>\t<bits>\t<bucket>\t<wg size>\t<engine>
+//
+// malformed lines are just skipped
+static void
+load_tune_table()
+{
+  std::ifstream f{ tune_cache_path() };
+  std::string line;
+
+  while (std::getline(f, line)) {
+    const size_t e = line.rfind('\t');
+    if (e == std::string::npos || e == 0) {
+      continue;
+    }
+    const size_t w = line.rfind('\t', e - 1);
+    if (w == std::string::npos) {
+      continue;
+    }
+
+    const uint wg_size = std::strtoul(line.c_str() + w + 1, nullptr, 10);
+    const uint engine = std::strtoul(line.c_str() + e + 1, nullptr, 10);
+    if (wg_size == 0 || engine > (uint)engine_t::implicit) {
+      continue;
+    }
+
+    tune_table[line.substr(0, w)] =
+      tuned_config{ wg_size, static_cast<engine_t>(engine) };
+  }
+}
+
+static void
+store_tune_entry(const std::string& key, const tuned_config cfg)
+{
+  std::ofstream f{ tune_cache_path(), std::ios::app };
+  f << key << "\t" << cfg.wg_size << "\t" << (uint)cfg.engine << "\n";
+}
+
+// tuned work-group size is for some dimension in same bucket, so it
+// may not divide this one
+static uint
+fit_wg_size(uint wg_size, const uint dim)
+{
+  while (wg_size > 1 && (wg_size > dim || dim % wg_size != 0)) {
+    wg_size >>= 1;
+  }
+  return wg_size;
+}
+
+template<typename T>
+int64_t
+run_engine(sycl::queue& q,
+           const engine_t engine,
+           const T* mat,
+           T* const eigen_val,
+           T* const eigen_vec,
+           const uint dim,
+           const uint wg_size,
+           uint* const iter_count)
+{
+  switch (engine) {
+    case engine_t::fused:
+      return fused_similarity_transform(
+        q, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+    case engine_t::implicit:
+      return implicit_similarity_transform(
+        q, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+    default:
+      return similarity_transform(
+        q, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+  }
+}
+
+// Work-group sizes worth timing for `dim`: every power of 2 dividing it,
+// starting at 1, so that there's always at least one, and `dim` itself,
+// when whole matrix row fits in one work-group
+static std::vector<uint>
+wg_size_candidates(const uint dim, const uint max_wg_size)
+{
+  std::vector<uint> wg_sizes;
+  for (uint wg_size = 1; wg_size <= dim && wg_size <= max_wg_size;
+       wg_size <<= 1) {
+    if (dim % wg_size == 0) {
+      wg_sizes.push_back(wg_size);
+    }
+  }
+  if (dim <= max_wg_size && (dim & (dim - 1)) != 0) {
+    wg_sizes.push_back(dim);
+  }
+  return wg_sizes;
+}
+
+template<typename T>
+static tuned_config
+run_tuning(sycl::queue& q, const uint dim)
+{
+  const uint max_wg_size =
+    q.get_device().get_info<sycl::info::device::max_work_group_size>();
+
+  T* mat = (T*)malloc(sizeof(T) * dim * dim);
+  T* eigen_val = (T*)malloc(sizeof(T) * 1);
+  T* eigen_vec = (T*)malloc(sizeof(T) * dim * 1);
+  uint iter_count = 0;
+
+  generate_hilbert_matrix(q, mat, dim);
+
+  tuned_config best{ fit_wg_size(max_wg_size, dim), engine_t::plain };
+  int64_t best_tm = std::numeric_limits<int64_t>::max();
+
+  const engine_t engines[] = { engine_t::plain,
+                               engine_t::fused,
+                               engine_t::implicit };
+
+  for (const engine_t engine : engines) {
+    // first run of each engine pays JIT compilation cost, which
+    // must not be accounted for
+    run_engine(
+      q, engine, mat, eigen_val, eigen_vec, dim, best.wg_size, &iter_count);
+
+    for (const uint wg_size : wg_size_candidates(dim, max_wg_size)) {
+      // engines report in milliseconds, which is too coarse for
+      // smaller matrices, so I'm timing it here
+      tp start = std::chrono::steady_clock::now();
+      run_engine(
+        q, engine, mat, eigen_val, eigen_vec, dim, wg_size, &iter_count);
+      tp end = std::chrono::steady_clock::now();
+
+      const int64_t tm =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+      if (tm < best_tm) {
+        best_tm = tm;
+        best = tuned_config{ wg_size, engine };
+      }
+    }
+  }
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return best;
+}
+
+template<typename T>
+tuned_config
+autotune(sycl::queue& q, const uint dim)
+{
+  // nothing to choose from, single work-group it is
+  if (dim < 32) {
+    return tuned_config{ dim, engine_t::plain };
+  }
+
+  const std::string key = tune_key<T>(q.get_device(), dim);
+
+  {
+    std::lock_guard<std::mutex> lock{ tune_lock };
+    if (!tune_table_loaded) {
+      load_tune_table();
+      tune_table_loaded = true;
+    }
+
+    auto itr = tune_table.find(key);
+    if (itr != tune_table.end()) {
+      tuned_config cfg = itr->second;
+      cfg.wg_size = fit_wg_size(cfg.wg_size, dim);
+      return cfg;
+    }
+  }
+
+  // not holding lock while tuning, which takes a while; if some other thread
+  // tunes same bucket concurrently, last one to finish wins
+  const tuned_config cfg = run_tuning<T>(q, dim);
+
+  {
+    std::lock_guard<std::mutex> lock{ tune_lock };
+    tune_table[key] = cfg;
+    store_tune_entry(key, cfg);
+  }
+
+  return cfg;
+}
+
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     uint* const iter_count)
+{
+  // nothing to tune, for fixed small dimensions
+  int64_t ts = 0;
+  if (small_similarity_transform(
+        mat, eigen_val, eigen_vec, dim, layout_t::row_major, iter_count, &ts)) {
+    return ts / 1000;
+  }
+
+  const tuned_config cfg = autotune<T>(q, dim);
+  return run_engine(
+    q, cfg.engine, mat, eigen_val, eigen_vec, dim, cfg.wg_size, iter_count);
+}
+
+template tuned_config
+autotune<float>(sycl::queue& q, const uint dim);
+
+template tuned_config
+autotune<double>(sycl::queue& q, const uint dim);
+
+template int64_t
+similarity_transform<float>(sycl::queue& q,
+                            const float* mat,
+                            float* const eigen_val,
+                            float* const eigen_vec,
+                            const uint dim,
+                            uint* const iter_count);
+
+template int64_t
+similarity_transform<double>(sycl::queue& q,
+                             const double* mat,
+                             double* const eigen_val,
+                             double* const eigen_vec,
+                             const uint dim,
+                             uint* const iter_count);
+
+template int64_t
+run_engine<float>(sycl::queue& q,
+                  const engine_t engine,
+                  const float* mat,
+                  float* const eigen_val,
+                  float* const eigen_vec,
+                  const uint dim,
+                  const uint wg_size,
+                  uint* const iter_count);
+
+template int64_t
+run_engine<double>(sycl::queue& q,
+                   const engine_t engine,
+                   const double* mat,
+                   double* const eigen_val,
+                   double* const eigen_vec,
+                   const uint dim,
+                   const uint wg_size,
+                   uint* const iter_count);
@@ -0,0 +1,304 @@
+#include "batched_similarity_transform.hpp"
+#include <chrono>
+
+typedef sycl::accessor<uint,
+                       1,
+                       sycl::access::mode::write,
+                       sycl::access::target::global_buffer>
+  global_count_writer;
+
+template<typename T>
+class kernelBatchedSimilarityTransformWG;
+
+template<typename T>
+class kernelBatchedSimilarityTransformSG;
+
+template<typename T>
+int64_t
+batched_similarity_transform(sycl::queue& q,
+                             const T* mats,
+                             T* const eigen_vals,
+                             T* const eigen_vecs,
+                             const uint batch,
+                             const uint dim,
+                             const uint wg_size,
+                             uint* const iter_counts)
+{
+  int64_t ts = 0;
+
+  {
+    const size_t mats_len = (size_t)batch * dim * dim;
+    const size_t vecs_len = (size_t)batch * dim;
+
+    buffer_1d_t<T> b_mats{ mats, sycl::range<1>{ mats_len } };
+    buffer_1d_t<T> b_eigen_vals{ eigen_vals, sycl::range<1>{ batch } };
+    buffer_1d_t<T> b_eigen_vecs{ eigen_vecs, sycl::range<1>{ vecs_len } };
+    sycl::buffer<uint, 1> b_iter_counts{ iter_counts, sycl::range<1>{ batch } };
+
+    tp start = std::chrono::steady_clock::now();
+
+    // matrices which fit in a subgroup are owned by one subgroup, so that
+    // whole solve happens in registers, using only subgroup collectives
+    if (dim <= 32) {
+      batched_similarity_transform_sg(
+        q, b_mats, b_eigen_vals, b_eigen_vecs, b_iter_counts, batch, dim, {})
+        .wait();
+    } else {
+      batched_similarity_transform_wg(q,
+                                      b_mats,
+                                      b_eigen_vals,
+                                      b_eigen_vecs,
+                                      b_iter_counts,
+                                      batch,
+                                      dim,
+                                      wg_size,
+                                      {})
+        .wait();
+    }
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+  }
+
+  return ts;
+}
+
+template<typename T>
+sycl::event
+batched_similarity_transform_wg(sycl::queue& q,
+                                buffer_1d_t<T> mats,
+                                buffer_1d_t<T> eigen_vals,
+                                buffer_1d_t<T> eigen_vecs,
+                                sycl::buffer<uint, 1> iter_counts,
+                                const uint batch,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_mats{ mats, h };
+    global_1d_writer_t<T> acc_eigen_vals{ eigen_vals, h, sycl::no_init };
+    global_1d_writer_t<T> acc_eigen_vecs{ eigen_vecs, h, sycl::no_init };
+    global_count_writer acc_iter_counts{ iter_counts, h, sycl::no_init };
+    local_1d_reader_writer_t<T> lds_vec{ sycl::range<1>{ dim }, h };
+    local_1d_reader_writer_t<T> lds_sum{ sycl::range<1>{ dim }, h };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelBatchedSimilarityTransformWG<T>>(
+      sycl::nd_range<1>{ sycl::range<1>{ (size_t)batch * wg_size },
+                         sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(32)]] {
+        sycl::group<1> grp = it.get_group();
+
+        const size_t b = it.get_group(0);
+        const size_t l_id = it.get_local_id(0);
+        const size_t off = b * dim * dim;
+
+        for (size_t r = l_id; r < dim; r += wg_size) {
+          lds_vec[r] = T(1);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        // same rounds as `implicit_similarity_transform`, but matrix
+        // belongs to this work group only, so eigen vector & row sums
+        // stay in local memory, while reductions are work group local
+        uint i = 0;
+        for (; i < MAX_ITR; i++) {
+          T loc_max = T(0);
+          for (size_t r = l_id; r < dim; r += wg_size) {
+            T sum = T(0);
+            for (size_t c = 0; c < dim; c++) {
+              sum += acc_mats[off + r * dim + c] * lds_vec[c];
+            }
+            sum /= lds_vec[r];
+
+            lds_sum[r] = sum;
+            loc_max = sycl::max(loc_max, sum);
+          }
+
+          // all row sums must be in place, before neighbours are compared
+          sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+          const T max =
+            sycl::reduce_over_group(grp, loc_max, sycl::maximum<T>());
+
+          bool loc_res = true;
+          for (size_t r = l_id; r < dim; r += wg_size) {
+            lds_vec[r] *= (lds_sum[r] / max);
+
+            const T diff = sycl::abs(lds_sum[r] - lds_sum[(r + 1) % dim]);
+            loc_res &= diff < EPS_T<T>;
+          }
+
+          const bool res = sycl::all_of_group(grp, loc_res);
+
+          // updated eigen vector is read by all in next round
+          sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+          if (res) {
+            break;
+          }
+        }
+
+        for (size_t r = l_id; r < dim; r += wg_size) {
+          acc_eigen_vecs[b * dim + r] = lds_vec[r];
+        }
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          acc_eigen_vals[b] = lds_sum[0];
+          acc_iter_counts[b] = i;
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T>
+sycl::event
+batched_similarity_transform_sg(sycl::queue& q,
+                                buffer_1d_t<T> mats,
+                                buffer_1d_t<T> eigen_vals,
+                                buffer_1d_t<T> eigen_vecs,
+                                sycl::buffer<uint, 1> iter_counts,
+                                const uint batch,
+                                const uint dim,
+                                std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_mats{ mats, h };
+    global_1d_writer_t<T> acc_eigen_vals{ eigen_vals, h, sycl::no_init };
+    global_1d_writer_t<T> acc_eigen_vecs{ eigen_vecs, h, sycl::no_init };
+    global_count_writer acc_iter_counts{ iter_counts, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    // work group is exactly one subgroup, so that one matrix is owned
+    // by one subgroup
+    h.parallel_for<kernelBatchedSimilarityTransformSG<T>>(
+      sycl::nd_range<1>{ sycl::range<1>{ (size_t)batch * 32 },
+                         sycl::range<1>{ 32 } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(32)]] {
+        sycl::sub_group sg = it.get_sub_group();
+
+        const size_t b = it.get_group(0);
+        const size_t off = b * dim * dim;
+
+        // work item `r` owns row `r` of matrix; when there are more work
+        // items than rows, spare ones still take part in collectives,
+        // but only with values which don't change result
+        const uint r = sg.get_local_id()[0];
+        const bool active = r < dim;
+
+        T vec = T(1);
+        T sum = T(0);
+
+        uint i = 0;
+        for (; i < MAX_ITR; i++) {
+          sum = T(0);
+          for (uint c = 0; c < dim; c++) {
+            const T vec_c = sycl::group_broadcast(sg, vec, c);
+            if (active) {
+              sum += acc_mats[off + r * dim + c] * vec_c;
+            }
+          }
+          sum = active ? sum / vec : T(0);
+
+          const T max = sycl::reduce_over_group(sg, sum, sycl::maximum<T>());
+
+          // row sum of cyclically next row, for stopping criteria
+          const T next = sg.shuffle(sum, active ? (r + 1) % dim : 0);
+
+          if (active) {
+            vec *= (sum / max);
+          }
+
+          const bool res = sycl::all_of_group(
+            sg, !active || sycl::abs(sum - next) < EPS_T<T>);
+          if (res) {
+            break;
+          }
+        }
+
+        if (active) {
+          acc_eigen_vecs[b * dim + r] = vec;
+        }
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          acc_eigen_vals[b] = sum;
+          acc_iter_counts[b] = i;
+        }
+      });
+  });
+
+  return evt;
+}
+
+template int64_t
+batched_similarity_transform<float>(sycl::queue& q,
+                                    const float* mats,
+                                    float* const eigen_vals,
+                                    float* const eigen_vecs,
+                                    const uint batch,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    uint* const iter_counts);
+
+template int64_t
+batched_similarity_transform<double>(sycl::queue& q,
+                                     const double* mats,
+                                     double* const eigen_vals,
+                                     double* const eigen_vecs,
+                                     const uint batch,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const iter_counts);
+
+template sycl::event
+batched_similarity_transform_wg<float>(sycl::queue& q,
+                                       buffer_1d_t<float> mats,
+                                       buffer_1d_t<float> eigen_vals,
+                                       buffer_1d_t<float> eigen_vecs,
+                                       sycl::buffer<uint, 1> iter_counts,
+                                       const uint batch,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       std::vector<sycl::event> evts);
+
+template sycl::event
+batched_similarity_transform_wg<double>(sycl::queue& q,
+                                        buffer_1d_t<double> mats,
+                                        buffer_1d_t<double> eigen_vals,
+                                        buffer_1d_t<double> eigen_vecs,
+                                        sycl::buffer<uint, 1> iter_counts,
+                                        const uint batch,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        std::vector<sycl::event> evts);
+
+template sycl::event
+batched_similarity_transform_sg<float>(sycl::queue& q,
+                                       buffer_1d_t<float> mats,
+                                       buffer_1d_t<float> eigen_vals,
+                                       buffer_1d_t<float> eigen_vecs,
+                                       sycl::buffer<uint, 1> iter_counts,
+                                       const uint batch,
+                                       const uint dim,
+                                       std::vector<sycl::event> evts);
+
+template sycl::event
+batched_similarity_transform_sg<double>(sycl::queue& q,
+                                        buffer_1d_t<double> mats,
+                                        buffer_1d_t<double> eigen_vals,
+                                        buffer_1d_t<double> eigen_vecs,
+                                        sycl::buffer<uint, 1> iter_counts,
+                                        const uint batch,
+                                        const uint dim,
+                                        std::vector<sycl::event> evts);
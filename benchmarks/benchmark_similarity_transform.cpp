@@ -1,18 +1,140 @@
+#include <algorithm>
 #include <benchmarks.hpp>
+#include <cassert>
+#include <fstream>
 
+template<typename T>
 int64_t
 benchmark_similarity_transform(sycl::queue& q,
                                const uint dim,
                                const uint wg_size,
                                uint* const itr_count)
+{
+  T* mat = (T*)malloc(sizeof(T) * dim * dim);
+  T* eigen_val = (T*)malloc(sizeof(T) * 1);
+  T* eigen_vec = (T*)malloc(sizeof(T) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+  int64_t tm =
+    similarity_transform(q, mat, eigen_val, eigen_vec, dim, wg_size, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_autotuned_similarity_transform(sycl::queue& q,
+                                         const uint dim,
+                                         tuned_config* const cfg,
+                                         uint* const itr_count)
 {
   float* mat = (float*)malloc(sizeof(float) * dim * dim);
   float* eigen_val = (float*)malloc(sizeof(float) * 1);
   float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
 
+  // tuning ( if not yet cached ) happens here, so that it's not timed
+  *cfg = autotune<float>(q, dim);
+
   generate_hilbert_matrix(q, mat, dim);
   int64_t tm =
-    similarity_transform(q, mat, eigen_val, eigen_vec, dim, wg_size, itr_count);
+    similarity_transform(q, mat, eigen_val, eigen_vec, dim, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_implicit_similarity_transform(sycl::queue& q,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+  int64_t tm = implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, wg_size, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_native_similarity_transform(sycl::queue& q,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      int64_t* const sycl_tm,
+                                      uint* const sycl_itr_count,
+                                      uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+
+  // both leave matrix untouched, so it's reused
+  *sycl_tm = implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, wg_size, sycl_itr_count);
+  int64_t tm =
+    native_similarity_transform(mat, eigen_val, eigen_vec, dim, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_small_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     int64_t* const generic_tm)
+{
+  // generic engine takes way longer, so it's repeated fewer times
+  const uint small_rounds = 1u << 12;
+  const uint generic_rounds = 1u << 4;
+
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+  uint itr_count = 0;
+  int64_t ts = 0;
+
+  generate_hilbert_matrix(q, mat, dim);
+
+  tp start = std::chrono::steady_clock::now();
+  for (uint i = 0; i < small_rounds; i++) {
+    small_similarity_transform(
+      mat, eigen_val, eigen_vec, dim, layout_t::row_major, &itr_count, &ts);
+  }
+  tp end = std::chrono::steady_clock::now();
+
+  int64_t tm =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+    small_rounds;
+
+  start = std::chrono::steady_clock::now();
+  for (uint i = 0; i < generic_rounds; i++) {
+    implicit_similarity_transform(
+      q, mat, eigen_val, eigen_vec, dim, dim, &itr_count);
+  }
+  end = std::chrono::steady_clock::now();
+
+  *generic_tm =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+    generic_rounds;
 
   std::free(mat);
   std::free(eigen_val);
@@ -21,6 +143,430 @@ benchmark_similarity_transform(sycl::queue& q,
   return tm;
 }
 
+// Time ( in microseconds ) it takes to complete `in_flight` independent
+// solves of Hilbert matrix, all started together, without waiting for any
+int64_t
+benchmark_async_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     const uint in_flight)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_vals = (float*)malloc(sizeof(float) * in_flight);
+  float* eigen_vecs = (float*)malloc(sizeof(float) * in_flight * dim);
+  uint* iter_counts = (uint*)malloc(sizeof(uint) * in_flight);
+
+  // all solves share same read-only matrix
+  generate_hilbert_matrix(q, mat, dim);
+
+  std::vector<std::future<int64_t>> solves;
+  solves.reserve(in_flight);
+
+  tp start = std::chrono::steady_clock::now();
+  for (uint i = 0; i < in_flight; i++) {
+    solves.push_back(async_similarity_transform(q,
+                                                (const float*)mat,
+                                                eigen_vals + i,
+                                                eigen_vecs + i * dim,
+                                                dim,
+                                                wg_size,
+                                                solver_options_t<float>{},
+                                                iter_counts + i));
+  }
+  for (auto& solve : solves) {
+    solve.get();
+  }
+  tp end = std::chrono::steady_clock::now();
+
+  int64_t tm =
+    std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  std::free(mat);
+  std::free(eigen_vals);
+  std::free(eigen_vecs);
+  std::free(iter_counts);
+
+  return tm;
+}
+
+// Solves Hilbert matrix within `budget`, from now, writing bounds on eigen
+// value to `bounds`
+int64_t
+benchmark_deadline_similarity_transform(sycl::queue& q,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        const std::chrono::milliseconds budget,
+                                        float* const bounds,
+                                        uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+
+  solver_options_t<float> opts;
+  opts.deadline = std::chrono::steady_clock::now() + budget;
+
+  int64_t tm = implicit_similarity_transform<float>(q,
+                                                    mat,
+                                                    eigen_val,
+                                                    eigen_vec,
+                                                    nullptr,
+                                                    bounds,
+                                                    dim,
+                                                    wg_size,
+                                                    opts,
+                                                    itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+// Solves Hilbert matrix, then drifts it a bit & solves it again, once cold
+// ( count returned using `cold_itr_count` ) and once warm started from
+// previous eigen vector; time taken by warm started solve is returned
+int64_t
+benchmark_warm_similarity_transform(sycl::queue& q,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    uint* const cold_itr_count,
+                                    uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+  float* tmp_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+  implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, wg_size, itr_count);
+
+  // next sample of slowly drifting matrix
+  for (uint i = 0; i < dim; i++) {
+    for (uint j = 0; j < dim; j++) {
+      mat[i * dim + j] *= 1.f + 1e-3f * (float)((i + j) % 7) / 7.f;
+    }
+  }
+
+  implicit_similarity_transform(
+    q, mat, eigen_val, tmp_vec, dim, wg_size, cold_itr_count);
+  int64_t tm = implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, eigen_vec, dim, wg_size, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+  std::free(tmp_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_speculative_similarity_transform(sycl::queue& q,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           const uint check_interval,
+                                           uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+  int64_t tm = speculative_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, wg_size, check_interval, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_batched_similarity_transform(sycl::queue& q,
+                                       const uint batch,
+                                       const uint dim,
+                                       const uint wg_size)
+{
+  float* mats = (float*)malloc(sizeof(float) * batch * dim * dim);
+  float* eigen_vals = (float*)malloc(sizeof(float) * batch);
+  float* eigen_vecs = (float*)malloc(sizeof(float) * batch * dim);
+  uint* iter_counts = (uint*)malloc(sizeof(uint) * batch);
+
+  // random positive matrices, each one of those converges on its own
+  generate_random_vector(mats, batch * dim * dim);
+
+  tp start = std::chrono::steady_clock::now();
+  batched_similarity_transform(
+    q, mats, eigen_vals, eigen_vecs, batch, dim, wg_size, iter_counts);
+  tp end = std::chrono::steady_clock::now();
+
+  int64_t tm =
+    std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  std::free(mats);
+  std::free(eigen_vals);
+  std::free(eigen_vecs);
+  std::free(iter_counts);
+
+  return tm;
+}
+
+int64_t
+benchmark_sparse_similarity_transform(sycl::queue& q,
+                                      const uint dim,
+                                      const uint nnz_per_row,
+                                      const uint wg_size,
+                                      uint* const itr_count)
+{
+  const uint nnz = dim * nnz_per_row;
+
+  uint* row_ptr = (uint*)malloc(sizeof(uint) * (dim + 1));
+  uint* col_idx = (uint*)malloc(sizeof(uint) * nnz);
+  float* vals = (float*)malloc(sizeof(float) * nnz);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_random_sparse_matrix(row_ptr, col_idx, vals, dim, nnz_per_row);
+  int64_t tm = sparse_similarity_transform(q,
+                                           row_ptr,
+                                           col_idx,
+                                           vals,
+                                           nnz,
+                                           eigen_val,
+                                           eigen_vec,
+                                           dim,
+                                           wg_size,
+                                           itr_count);
+
+  std::free(row_ptr);
+  std::free(col_idx);
+  std::free(vals);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_multi_similarity_transform(std::vector<sycl::queue>& qs,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(qs[0], mat, dim);
+  int64_t tm = multi_similarity_transform(
+    qs, mat, eigen_val, eigen_vec, dim, wg_size, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_streaming_similarity_transform(sycl::queue& q,
+                                         const uint dim,
+                                         const uint tile_rows,
+                                         const uint wg_size,
+                                         uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_hilbert_matrix(q, mat, dim);
+  int64_t tm = streaming_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, tile_rows, wg_size, itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+// Time it takes to get matrix from file into device memory, when file is
+// memory mapped & uploaded straight out of mapping, in comparison with reading
+// it into host buffer first ( returned using `read_tm` )
+//
+// Matrix file is generated only if it's not present already; returns -1,
+// when it can't be written or mapped
+int64_t
+benchmark_matrix_load(sycl::queue& q, const uint dim, int64_t* const read_tm)
+{
+  const std::string path = "hilbert_" + std::to_string(dim) + ".stmx";
+  const size_t len = sizeof(float) * dim * dim;
+
+  mapped_matrix_t m;
+  if (!map_matrix(path.c_str(), &m) || m.header.dim != dim ||
+      matrix_data<float>(m) == nullptr) {
+    unmap_matrix(&m);
+
+    float* mat = (float*)malloc(len);
+    generate_hilbert_matrix(q, mat, dim);
+    const bool written = write_matrix(path.c_str(), mat, dim);
+    std::free(mat);
+
+    if (!written) {
+      return -1;
+    }
+  } else {
+    unmap_matrix(&m);
+  }
+
+  float* d_mat = sycl::malloc_device<float>((size_t)dim * dim, q);
+
+  tp start_0 = std::chrono::steady_clock::now();
+  {
+    if (!map_matrix(path.c_str(), &m)) {
+      sycl::free(d_mat, q);
+      return -1;
+    }
+    q.memcpy(d_mat, matrix_data<float>(m), len).wait();
+    unmap_matrix(&m);
+  }
+  tp end_0 = std::chrono::steady_clock::now();
+
+  tp start_1 = std::chrono::steady_clock::now();
+  {
+    float* h_mat = (float*)malloc(len);
+
+    std::ifstream f{ path, std::ios::binary };
+    f.seekg(MATRIX_PAYLOAD_ALIGNMENT);
+    f.read(reinterpret_cast<char*>(h_mat), len);
+    q.memcpy(d_mat, h_mat, len).wait();
+
+    std::free(h_mat);
+  }
+  tp end_1 = std::chrono::steady_clock::now();
+
+  sycl::free(d_mat, q);
+
+  *read_tm =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end_1 - start_1)
+      .count();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end_0 - start_0)
+    .count();
+}
+
+// Positive matrix of `dim` x `dim`, from one of families convergence is
+// compared across
+static void
+generate_matrix(sycl::queue& q,
+                float* const mat,
+                const uint dim,
+                const matrix_family_t family)
+{
+  switch (family) {
+    case matrix_family_t::hilbert:
+      generate_hilbert_matrix(q, mat, dim);
+      break;
+    case matrix_family_t::random:
+      generate_random_vector(mat, dim * dim);
+      break;
+    case matrix_family_t::banded:
+      // tridiagonal, with tiny positive fill elsewhere; dominant eigen
+      // values are close together, so it converges slowly
+      for (uint i = 0; i < dim; i++) {
+        for (uint j = 0; j < dim; j++) {
+          const uint d = i > j ? i - j : j - i;
+          mat[i * dim + j] = d == 0 ? 2.f : d == 1 ? 1.f : 1e-4f;
+        }
+      }
+      break;
+  }
+}
+
+int64_t
+benchmark_accelerated_similarity_transform(sycl::queue& q,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           const matrix_family_t family,
+                                           const uint extrapolation_interval,
+                                           int64_t* const plain_tm,
+                                           uint* const plain_itr_count,
+                                           uint* const itr_count)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+
+  generate_matrix(q, mat, dim, family);
+
+  *plain_tm = implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, dim, wg_size, plain_itr_count);
+  int64_t tm = accelerated_similarity_transform(q,
+                                                mat,
+                                                eigen_val,
+                                                eigen_vec,
+                                                dim,
+                                                wg_size,
+                                                extrapolation_interval,
+                                                itr_count);
+
+  std::free(mat);
+  std::free(eigen_val);
+  std::free(eigen_vec);
+
+  return tm;
+}
+
+int64_t
+benchmark_mixed_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     const bool hilbert,
+                                     int64_t* const fp32_tm,
+                                     float* const eigen_val_err,
+                                     float* const eigen_vec_err)
+{
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* eigen_val_0 = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec_0 = (float*)malloc(sizeof(float) * dim * 1);
+  float* eigen_val_1 = (float*)malloc(sizeof(float) * 1);
+  float* eigen_vec_1 = (float*)malloc(sizeof(float) * dim * 1);
+  uint itr_count = 0;
+
+  if (hilbert) {
+    generate_hilbert_matrix(q, mat, dim);
+  } else {
+    generate_random_vector(mat, dim * dim);
+  }
+
+  // single precision storage is reference, against which both time and
+  // error of half precision storage is reported
+  *fp32_tm = implicit_similarity_transform(
+    q, mat, eigen_val_0, eigen_vec_0, dim, wg_size, &itr_count);
+  int64_t tm = mixed_similarity_transform<sycl::half>(
+    q, mat, eigen_val_1, eigen_vec_1, dim, wg_size, &itr_count);
+
+  *eigen_val_err = std::abs(*eigen_val_0 - *eigen_val_1);
+  *eigen_vec_err = 0.f;
+  for (uint i = 0; i < dim; i++) {
+    const float err = std::abs(*(eigen_vec_0 + i) - *(eigen_vec_1 + i));
+    *eigen_vec_err = std::max(*eigen_vec_err, err);
+  }
+
+  std::free(mat);
+  std::free(eigen_val_0);
+  std::free(eigen_vec_0);
+  std::free(eigen_val_1);
+  std::free(eigen_vec_1);
+
+  return tm;
+}
+
 int64_t
 benchmark_sum_across_rows_kernel_v0(sycl::queue& q,
                                     const uint dim,
@@ -158,6 +704,102 @@ benchmark_sum_across_rows_kernel_v2(sycl::queue& q,
   return tm;
 }
 
+// Rows of matrix in one work group's tile, of v3 kernels, where each row
+// is one subgroup of `sg_size` work items; shrunk till there's whole
+// number of tiles
+static uint
+v3_tile_rows(const uint dim, const uint wg_size, const uint sg_size)
+{
+  uint tile_rows = std::max(1u, std::min(wg_size / sg_size, dim));
+  while (dim % tile_rows != 0) {
+    tile_rows >>= 1;
+  }
+  return tile_rows;
+}
+
+int64_t
+benchmark_sum_across_rows_kernel_v3(sycl::queue& q,
+                                    const uint dim,
+                                    const uint wg_size)
+{
+  // each row of work group's tile is one subgroup, reading `W` consecutive
+  // elements at a time, while last `dim % W` elements of row are read one
+  // at a time
+  constexpr uint SG = 32;
+  constexpr uint W = 4;
+  const uint tile_rows = v3_tile_rows(dim, wg_size, SG);
+
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* vec = (float*)malloc(sizeof(float) * dim * 1);
+  int64_t tm = 0;
+
+  generate_random_vector(mat, dim * dim);
+  {
+    buffer_2d buf_mat{ mat, sycl::range<2>{ dim, dim } };
+    buffer_1d buf_vec{ vec, sycl::range<1>{ dim } };
+
+    tp start = std::chrono::steady_clock::now();
+
+    q.submit([&](sycl::handler& h) {
+      global_2d_reader acc_mat{ buf_mat, h };
+      global_1d_writer acc_vec{ buf_vec, h, sycl::no_init };
+
+      h.parallel_for<class kernelSumAcrossRowsv3>(
+        sycl::nd_range<2>{ sycl::range<2>{ dim, SG },
+                           sycl::range<2>{ tile_rows, SG } },
+        [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+          sycl::sub_group sg = it.get_sub_group();
+
+          const size_t r = it.get_global_id(0);
+          const size_t l = it.get_local_id(1);
+          const size_t vecs = dim / W;
+          const auto row = acc_mat.get_pointer() + r * dim;
+
+          // subgroup walks whole row, so that row sum is complete after
+          // subgroup reduction & no atomic update is required
+          sycl::vec<float, W> acc{ 0.f };
+          for (size_t c = l; c < vecs; c += SG) {
+            sycl::vec<float, W> v;
+            v.load(0, row + c * W);
+            acc += v;
+          }
+
+          float loc_sum = acc.x() + acc.y() + acc.z() + acc.w();
+          for (size_t c = vecs * W + l; c < dim; c += SG) {
+            loc_sum += row[c];
+          }
+
+          const float sum =
+            sycl::reduce_over_group(sg, loc_sum, sycl::plus<float>());
+
+          if (sycl::ext::oneapi::leader(sg)) {
+            acc_vec[r] = sum;
+          }
+        });
+    });
+    q.wait();
+
+    tp end = std::chrono::steady_clock::now();
+
+    tm = std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+           .count();
+  }
+
+  // same row sums as v2 computes, summed on host, in double precision
+  for (uint r = 0; r < dim; r++) {
+    double sum = 0.;
+    for (uint c = 0; c < dim; c++) {
+      sum += mat[r * dim + c];
+    }
+    assert(std::abs(vec[r] - sum) <= 1e-4 * sum);
+  }
+
+  std::free(mat);
+  std::free(vec);
+
+  return tm;
+}
+
 int64_t
 benchmark_find_vector_max_v0(sycl::queue& q, const uint dim, const uint wg_size)
 {
@@ -404,6 +1046,147 @@ benchmark_compute_next_matrix(sycl::queue& q,
   return tm;
 }
 
+int64_t
+benchmark_compute_next_matrix_v3(sycl::queue& q,
+                                 const uint dim,
+                                 const uint wg_size)
+{
+  // same tiling as `benchmark_sum_across_rows_kernel_v3`, but each
+  // subgroup rescales its row, `W` elements at a time
+  constexpr uint SG = 32;
+  constexpr uint W = 8;
+  const uint tile_rows = v3_tile_rows(dim, wg_size, SG);
+
+  float* mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* ref_mat = (float*)malloc(sizeof(float) * dim * dim);
+  float* vec = (float*)malloc(sizeof(float) * dim * 1);
+  float* eigen_vec = (float*)malloc(sizeof(float) * dim * 1);
+  float* max = (float*)malloc(sizeof(float) * 1);
+  int64_t tm = 0;
+
+  generate_random_vector(mat, dim * dim);
+  memcpy(ref_mat, mat, sizeof(float) * dim * dim);
+  {
+    buffer_2d buf_mat{ mat, sycl::range<2>{ dim, dim } };
+    buffer_1d buf_vec{ vec, sycl::range<1>{ dim } };
+    buffer_1d buf_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d buf_max{ max, sycl::range<1>{ 1 } };
+
+    initialise_eigen_vector(q, buf_eigen_vec, dim, {}).wait();
+    sum_across_rows(q, buf_mat, buf_vec, dim, wg_size, {}).wait();
+    find_max(q, buf_vec, buf_max, dim, wg_size, {}).wait();
+    compute_eigen_vector(q, buf_vec, buf_max, buf_eigen_vec, dim, wg_size, {})
+      .wait();
+
+    tp start = std::chrono::steady_clock::now();
+
+    q.submit([&](sycl::handler& h) {
+      global_2d_reader_writer acc_mat{ buf_mat, h };
+      global_1d_reader acc_vec{ buf_vec, h };
+
+      h.parallel_for<class kernelComputeNextMatrixv3>(
+        sycl::nd_range<2>{ sycl::range<2>{ dim, SG },
+                           sycl::range<2>{ tile_rows, SG } },
+        [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+          const size_t r = it.get_global_id(0);
+          const size_t l = it.get_local_id(1);
+          const size_t vecs = dim / W;
+          const auto row = acc_mat.get_pointer() + r * dim;
+
+          // row scaling factor is read once, instead of per element
+          const float row_scale = 1.f / acc_vec[r];
+
+          for (size_t c = l; c < vecs; c += SG) {
+            sycl::vec<float, W> m;
+            sycl::vec<float, W> v;
+            m.load(0, row + c * W);
+            v.load(c, acc_vec.get_pointer());
+
+            m *= v * row_scale;
+            m.store(0, row + c * W);
+          }
+          for (size_t c = vecs * W + l; c < dim; c += SG) {
+            row[c] *= acc_vec[c] * row_scale;
+          }
+        });
+    });
+    q.wait();
+
+    tp end = std::chrono::steady_clock::now();
+
+    tm = std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+           .count();
+  }
+
+  // same rescaling as `compute_next_matrix`, done on host, with row sums
+  // which were used on device
+  for (uint r = 0; r < dim; r++) {
+    for (uint c = 0; c < dim; c++) {
+      const float expected = ref_mat[r * dim + c] * vec[c] / vec[r];
+      assert(std::abs(mat[r * dim + c] - expected) <= 1e-4f * expected);
+    }
+  }
+
+  std::free(mat);
+  std::free(ref_mat);
+  std::free(vec);
+  std::free(eigen_vec);
+  std::free(max);
+
+  return tm;
+}
+
+int64_t
+benchmark_fused_next_matrix(sycl::queue& q,
+                            const uint dim,
+                            const uint wg_size,
+                            int64_t* const unfused_tm)
+{
+  float* mat_0 = (float*)malloc(sizeof(float) * dim * dim);
+  float* mat_1 = (float*)malloc(sizeof(float) * dim * dim);
+  float* vec = (float*)malloc(sizeof(float) * dim * 1);
+  float* next_vec = (float*)malloc(sizeof(float) * dim * 1);
+  int64_t tm = 0;
+
+  generate_random_vector(mat_0, dim * dim);
+  memcpy(mat_1, mat_0, sizeof(float) * dim * dim);
+  {
+    buffer_2d buf_mat_0{ mat_0, sycl::range<2>{ dim, dim } };
+    buffer_2d buf_mat_1{ mat_1, sycl::range<2>{ dim, dim } };
+    buffer_1d buf_vec{ vec, sycl::range<1>{ dim } };
+    buffer_1d buf_next_vec{ next_vec, sycl::range<1>{ dim } };
+
+    sum_across_rows(q, buf_mat_0, buf_vec, dim, wg_size, {}).wait();
+
+    // one unfused iteration rescales matrix and then sums across rows
+    // of rescaled matrix, in two different kernels
+    tp start = std::chrono::steady_clock::now();
+    compute_next_matrix(q, buf_mat_0, buf_vec, dim, wg_size, {});
+    sum_across_rows(q, buf_mat_0, buf_next_vec, dim, wg_size, {}).wait();
+    tp end = std::chrono::steady_clock::now();
+
+    *unfused_tm =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+
+    start = std::chrono::steady_clock::now();
+    compute_next_matrix_and_sum_rows(
+      q, buf_mat_1, buf_vec, buf_next_vec, dim, wg_size, {})
+      .wait();
+    end = std::chrono::steady_clock::now();
+
+    tm = std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+           .count();
+  }
+
+  std::free(mat_0);
+  std::free(mat_1);
+  std::free(vec);
+  std::free(next_vec);
+
+  return tm;
+}
+
 int64_t
 benchmark_stop_criteria_tester(sycl::queue& q,
                                const uint dim,
@@ -431,3 +1214,15 @@ benchmark_stop_criteria_tester(sycl::queue& q,
 
   return tm;
 }
+
+template int64_t
+benchmark_similarity_transform<float>(sycl::queue& q,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      uint* const itr_count);
+
+template int64_t
+benchmark_similarity_transform<double>(sycl::queue& q,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       uint* const itr_count);
@@ -0,0 +1,154 @@
+#include "eigen_solver.hpp"
+#include <chrono>
+
+template<typename T>
+class kernelTransposeInPlace;
+
+// Transposes `dim` x `dim` matrix in device memory, where each work item
+// swaps one element of strictly upper triangle with its mirror
+template<typename T>
+static sycl::event
+transpose_in_place(sycl::queue& q,
+                   T* const mat,
+                   const uint dim,
+                   std::vector<sycl::event> evts)
+{
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(evts);
+    h.parallel_for<kernelTransposeInPlace<T>>(
+      sycl::range<2>{ dim, dim }, [=](sycl::id<2> idx) {
+        const size_t r = idx[0];
+        const size_t c = idx[1];
+
+        if (c > r) {
+          const T tmp = mat[r * dim + c];
+          mat[r * dim + c] = mat[c * dim + r];
+          mat[c * dim + r] = tmp;
+        }
+      });
+  });
+}
+
+template<typename T>
+EigenSolver<T>::EigenSolver(sycl::queue& q, const uint max_dim)
+  : q_{ q }
+  , max_dim_{ max_dim }
+  , sg_size_{ sub_group_size(q.get_device()) }
+{
+  mat_ = sycl::malloc_device<T>((size_t)max_dim * max_dim, q_);
+  eigen_vec_ = sycl::malloc_device<T>(max_dim, q_);
+  sum_vec_ = sycl::malloc_device<T>(max_dim, q_);
+  max_elm_ = sycl::malloc_device<T>(1, q_);
+  ret_ = sycl::malloc_device<uint>(1, q_);
+}
+
+template<typename T>
+EigenSolver<T>::~EigenSolver()
+{
+  q_.wait();
+
+  sycl::free(mat_, q_);
+  sycl::free(eigen_vec_, q_);
+  sycl::free(sum_vec_, q_);
+  sycl::free(max_elm_, q_);
+  sycl::free(ret_, q_);
+}
+
+template<typename T>
+int64_t
+EigenSolver<T>::solve(const T* mat,
+                      T* const eigen_val,
+                      T* const eigen_vec,
+                      const uint dim,
+                      const uint wg_size,
+                      uint* const iter_count)
+{
+  return solve(mat,
+               eigen_val,
+               eigen_vec,
+               dim,
+               wg_size,
+               layout_t::row_major,
+               iter_count);
+}
+
+template<typename T>
+int64_t
+EigenSolver<T>::solve(const T* mat,
+                      T* const eigen_val,
+                      T* const eigen_vec,
+                      const uint dim,
+                      const uint wg_size,
+                      const layout_t layout,
+                      uint* const iter_count)
+{
+  // workspace is allocated for `max_dim` only, larger matrix would be
+  // written past its end
+  if (dim > max_dim_) {
+    return -1;
+  }
+
+  return dispatch_sub_group_size(sg_size_, [&](auto sg) {
+    return solve_impl<decltype(sg)::value>(
+      mat, eigen_val, eigen_vec, dim, wg_size, layout, iter_count);
+  });
+}
+
+template<typename T>
+template<uint SG>
+int64_t
+EigenSolver<T>::solve_impl(const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           const layout_t layout,
+                           uint* const iter_count)
+{
+  // matrix is packed with row stride `dim`, irrespective of `max_dim`
+  sycl::event evt_0 = q_.memcpy(mat_, mat, sizeof(T) * dim * dim);
+  if (layout == layout_t::col_major) {
+    evt_0 = transpose_in_place(q_, mat_, dim, { evt_0 });
+  }
+  sycl::event evt_1 = initialise_eigen_vector(q_, eigen_vec_, dim, {});
+
+  tp start = std::chrono::steady_clock::now();
+
+  std::vector<sycl::event> evts{ evt_0, evt_1 };
+
+  uint i = 0;
+  for (; i < MAX_ITR; i++) {
+    sycl::event evt_2 = sum_across_scaled_rows<T, SG>(
+      q_, mat_, eigen_vec_, sum_vec_, dim, wg_size, evts);
+    sycl::event evt_3 =
+      find_max<T, SG>(q_, sum_vec_, max_elm_, dim, wg_size, { evt_2 });
+    sycl::event evt_4 = compute_eigen_vector<T, SG>(
+      q_, sum_vec_, max_elm_, eigen_vec_, dim, wg_size, { evt_3 });
+    sycl::event evt_5 =
+      stop<T, SG>(q_, sum_vec_, ret_, dim, wg_size, { evt_2 });
+
+    uint ret = 0;
+    q_.memcpy(&ret, ret_, sizeof(uint), evt_5).wait();
+    evts = { evt_4 };
+
+    if (ret == 1) {
+      break;
+    }
+  }
+  *iter_count = i;
+
+  sycl::event::wait(evts);
+
+  tp end = std::chrono::steady_clock::now();
+  int64_t ts =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+  q_.memcpy(eigen_vec, eigen_vec_, sizeof(T) * dim);
+  q_.memcpy(eigen_val, sum_vec_, sizeof(T) * 1);
+  q_.wait();
+
+  return ts;
+}
+
+template class EigenSolver<float>;
+template class EigenSolver<double>;
@@ -0,0 +1,26 @@
+#pragma once
+#include <future>
+#include <similarity_transform.hpp>
+
+// Non-blocking variant of `implicit_similarity_transform`, which returns as
+// soon as solve is started; returned future becomes ready, with time taken
+// ( in ms ), once eigen value, eigen vector & iteration count are written
+// back to `eigen_val`, `eigen_vec` & `iter_count`
+//
+// Rounds are driven by their own host thread, which is the one blocking on
+// convergence flag after every round, so that many independent solves can
+// be in flight on same ( preferably out-of-order ) queue or on different
+// queues, while kernels of one overlap with host round trips of others
+//
+// `mat` must stay alive & unchanged until future is ready; queue is held
+// by value, so it can go out of scope at call site
+template<typename T>
+std::future<int64_t>
+async_similarity_transform(sycl::queue q,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           const solver_options_t<T> opts,
+                           uint* const iter_count);
@@ -0,0 +1,65 @@
+#pragma once
+#include <similarity_transform.hpp>
+
+// Similarity transform engines, which autotuner chooses from
+enum class engine_t : uint
+{
+  plain = 0,
+  fused = 1,
+  implicit = 2
+};
+
+struct tuned_config
+{
+  uint wg_size;
+  engine_t engine;
+};
+
+// Environment variable which can be used for overriding on-disk location of
+// autotuner cache, otherwise `DEFAULT_TUNE_CACHE` in current working directory
+// is used
+inline constexpr const char* TUNE_CACHE_ENV = "SIMILARITY_TRANSFORM_TUNE_CACHE";
+inline constexpr const char* DEFAULT_TUNE_CACHE = "similarity_transform.tune";
+
+// Finds best work-group size & engine for given device and dimension bucket
+// ( = ceil(log2(dim)) ), by timing all candidate work-group sizes ( powers
+// of 2 dividing `dim`, from 1 upward, and `dim` itself, when it fits in one
+// work-group ) with each engine, on a Hilbert matrix of `dim` x `dim`; so
+// whatever gets cached has been timed
+//
+// Sub-group size isn't tuned here, as engine entry points don't take it;
+// each one picks it per device, through `sub_group_size`, which matches
+// native SIMD width on CPUs
+//
+// Winner is stored in an on-disk cache, keyed by device name, driver version,
+// element type & dimension bucket, so that only first run on some device
+// pays tuning cost
+template<typename T>
+tuned_config
+autotune(sycl::queue& q, const uint dim);
+
+// Same as `similarity_transform` above, but work-group size & engine are
+// picked by autotuner, instead of being passed by caller; fixed small
+// dimensions skip both, see `small_similarity_transform`, in which case
+// returned time ( in milliseconds ) is mostly 0
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     uint* const iter_count);
+
+// Dispatches to one of similarity transform engines, with explicit
+// work-group size
+template<typename T>
+int64_t
+run_engine(sycl::queue& q,
+           const engine_t engine,
+           const T* mat,
+           T* const eigen_val,
+           T* const eigen_vec,
+           const uint dim,
+           const uint wg_size,
+           uint* const iter_count);
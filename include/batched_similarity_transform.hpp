@@ -0,0 +1,39 @@
+#pragma once
+#include <similarity_transform.hpp>
+
+// Solves a contiguous stack of `batch` many dim x dim matrices, each one
+// iterating to its own convergence inside one kernel launch, which is why
+// there's no host synchronization between rounds
+template<typename T>
+int64_t
+batched_similarity_transform(sycl::queue& q,
+                             const T* mats,
+                             T* const eigen_vals,
+                             T* const eigen_vecs,
+                             const uint batch,
+                             const uint dim,
+                             const uint wg_size,
+                             uint* const iter_counts);
+
+template<typename T>
+sycl::event
+batched_similarity_transform_wg(sycl::queue& q,
+                                buffer_1d_t<T> mats,
+                                buffer_1d_t<T> eigen_vals,
+                                buffer_1d_t<T> eigen_vecs,
+                                sycl::buffer<uint, 1> iter_counts,
+                                const uint batch,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template<typename T>
+sycl::event
+batched_similarity_transform_sg(sycl::queue& q,
+                                buffer_1d_t<T> mats,
+                                buffer_1d_t<T> eigen_vals,
+                                buffer_1d_t<T> eigen_vecs,
+                                sycl::buffer<uint, 1> iter_counts,
+                                const uint batch,
+                                const uint dim,
+                                std::vector<sycl::event> evts);
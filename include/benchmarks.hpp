@@ -1,7 +1,24 @@
 #pragma once
+#include <async_similarity_transform.hpp>
+#include <autotune.hpp>
+#include <batched_similarity_transform.hpp>
+#include <matrix_io.hpp>
+#include <mixed_similarity_transform.hpp>
+#include <multi_similarity_transform.hpp>
+#include <native_similarity_transform.hpp>
 #include <similarity_transform.hpp>
+#include <small_similarity_transform.hpp>
+#include <sparse_similarity_transform.hpp>
+#include <streaming_similarity_transform.hpp>
 #include <utils.hpp>
 
+enum class matrix_family_t
+{
+  hilbert,
+  random,
+  banded
+};
+
 int64_t
 benchmark_sum_across_rows_kernel_v0(sycl::queue& q,
                                     const uint dim,
@@ -17,12 +34,131 @@ benchmark_sum_across_rows_kernel_v2(sycl::queue& q,
                                     const uint dim,
                                     const uint wg_size);
 
+// Vectorised ( `sycl::vec` loads ) & tiled variant, where each row of
+// work group's tile is one subgroup walking whole matrix row, so that row
+// sum is written without any atomic update
+//
+// Any `dim` works: tile is made shorter till it divides `dim`, while
+// `dim % 4` trailing elements of each row are read one at a time. Result
+// is checked on host ( asserted ), after timing
+int64_t
+benchmark_sum_across_rows_kernel_v3(sycl::queue& q,
+                                    const uint dim,
+                                    const uint wg_size);
+
+template<typename T>
 int64_t
 benchmark_similarity_transform(sycl::queue& q,
                                const uint dim,
                                const uint wg_size,
                                uint* const itr_count);
 
+int64_t
+benchmark_autotuned_similarity_transform(sycl::queue& q,
+                                         const uint dim,
+                                         tuned_config* const cfg,
+                                         uint* const itr_count);
+
+int64_t
+benchmark_implicit_similarity_transform(sycl::queue& q,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        uint* const itr_count);
+
+// Solves same Hilbert matrix using SYCL implicit engine on `q` ( time
+// written to `sycl_tm` ) and native backend, whose time is returned
+int64_t
+benchmark_native_similarity_transform(sycl::queue& q,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      int64_t* const sycl_tm,
+                                      uint* const sycl_itr_count,
+                                      uint* const itr_count);
+
+// Mean latency ( in nanoseconds ) of solving Hilbert matrix of fixed small
+// dimension using compile-time specialised solver; mean latency of generic
+// implicit engine, on `q`, is written to `generic_tm`
+int64_t
+benchmark_small_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     int64_t* const generic_tm);
+
+int64_t
+benchmark_async_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     const uint in_flight);
+
+int64_t
+benchmark_deadline_similarity_transform(sycl::queue& q,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        const std::chrono::milliseconds budget,
+                                        float* const bounds,
+                                        uint* const itr_count);
+
+int64_t
+benchmark_warm_similarity_transform(sycl::queue& q,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    uint* const cold_itr_count,
+                                    uint* const itr_count);
+
+int64_t
+benchmark_speculative_similarity_transform(sycl::queue& q,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           const uint check_interval,
+                                           uint* const itr_count);
+
+int64_t
+benchmark_batched_similarity_transform(sycl::queue& q,
+                                       const uint batch,
+                                       const uint dim,
+                                       const uint wg_size);
+
+int64_t
+benchmark_sparse_similarity_transform(sycl::queue& q,
+                                      const uint dim,
+                                      const uint nnz_per_row,
+                                      const uint wg_size,
+                                      uint* const itr_count);
+
+int64_t
+benchmark_multi_similarity_transform(std::vector<sycl::queue>& qs,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const itr_count);
+
+int64_t
+benchmark_streaming_similarity_transform(sycl::queue& q,
+                                         const uint dim,
+                                         const uint tile_rows,
+                                         const uint wg_size,
+                                         uint* const itr_count);
+
+int64_t
+benchmark_matrix_load(sycl::queue& q, const uint dim, int64_t* const read_tm);
+
+int64_t
+benchmark_accelerated_similarity_transform(sycl::queue& q,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           const matrix_family_t family,
+                                           const uint extrapolation_interval,
+                                           int64_t* const plain_tm,
+                                           uint* const plain_itr_count,
+                                           uint* const itr_count);
+
+int64_t
+benchmark_mixed_similarity_transform(sycl::queue& q,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     const bool hilbert,
+                                     int64_t* const fp32_tm,
+                                     float* const eigen_val_err,
+                                     float* const eigen_vec_err);
+
 int64_t
 benchmark_find_vector_max_v0(sycl::queue& q,
                              const uint dim,
@@ -53,6 +189,21 @@ benchmark_compute_next_matrix(sycl::queue& q,
                               const uint dim,
                               const uint wg_size);
 
+// Vectorised & tiled variant of `compute_next_matrix`, same layout &
+// handling of any `dim` as `benchmark_sum_across_rows_kernel_v3`, with
+// `dim % 8` trailing elements of each row rescaled one at a time; checked
+// on host against same rescaling, after timing
+int64_t
+benchmark_compute_next_matrix_v3(sycl::queue& q,
+                                 const uint dim,
+                                 const uint wg_size);
+
+int64_t
+benchmark_fused_next_matrix(sycl::queue& q,
+                            const uint dim,
+                            const uint wg_size,
+                            int64_t* const unfused_tm);
+
 int64_t
 benchmark_stop_criteria_tester(sycl::queue& q,
                                const uint dim,
@@ -0,0 +1,60 @@
+#pragma once
+#include <matrix_io.hpp>
+#include <similarity_transform.hpp>
+
+// Reusable solver context, owning device side USM workspace for matrices of
+// dimension upto `max_dim`, so that repeated solves don't allocate/ release
+// any memory; it uses implicit scaling formulation, so input matrix is only
+// uploaded to workspace, never rewritten
+template<typename T>
+class EigenSolver
+{
+public:
+  EigenSolver(sycl::queue& q, const uint max_dim);
+  ~EigenSolver();
+
+  EigenSolver(const EigenSolver&) = delete;
+  EigenSolver& operator=(const EigenSolver&) = delete;
+
+  // Returns -1, without touching anything, if `dim` > `max_dim`
+  int64_t solve(const T* mat,
+                T* const eigen_val,
+                T* const eigen_vec,
+                const uint dim,
+                const uint wg_size,
+                uint* const iter_count);
+
+  // Matrix may also be column major ( say Fortran ordered array ), in which
+  // case it's transposed in place, in device workspace, after upload
+  int64_t solve(const T* mat,
+                T* const eigen_val,
+                T* const eigen_vec,
+                const uint dim,
+                const uint wg_size,
+                const layout_t layout,
+                uint* const iter_count);
+
+  uint max_dim() const { return max_dim_; }
+  sycl::queue& queue() { return q_; }
+
+private:
+  template<uint SG>
+  int64_t solve_impl(const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     const layout_t layout,
+                     uint* const iter_count);
+
+  sycl::queue q_;
+  const uint max_dim_;
+  // sub-group size kernels are dispatched with, chosen once for device
+  const uint sg_size_;
+
+  T* mat_ = nullptr;
+  T* eigen_vec_ = nullptr;
+  T* sum_vec_ = nullptr;
+  T* max_elm_ = nullptr;
+  uint* ret_ = nullptr;
+};
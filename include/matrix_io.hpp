@@ -0,0 +1,78 @@
+#pragma once
+#include <CL/sycl.hpp>
+#include <cstdint>
+
+// On-disk matrix format ( version 1 ), all fields in native byte order
+//
+// [ header | zero padding | payload ]
+//
+// where payload ( `dim` x `dim` elements of `dtype`, laid out as per `layout`
+// ) starts at `payload_offset`, which is always multiple of
+// `MATRIX_PAYLOAD_ALIGNMENT`, so that memory mapped payload is page aligned
+// & can be handed over to solver/ device upload as it's
+inline constexpr char MATRIX_MAGIC[4] = { 'S', 'T', 'M', 'X' };
+inline constexpr uint32_t MATRIX_VERSION = 1;
+inline constexpr uint64_t MATRIX_PAYLOAD_ALIGNMENT = 4096;
+
+enum class dtype_t : uint32_t
+{
+  f32 = 0,
+  f64 = 1,
+  f16 = 2
+};
+
+enum class layout_t : uint32_t
+{
+  row_major = 0,
+  col_major = 1
+};
+
+struct matrix_header_t
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t dim;
+  dtype_t dtype;
+  layout_t layout;
+  uint32_t reserved;
+  uint64_t payload_offset;
+};
+
+// Read-only memory mapping of matrix file, where `data` points to
+// first element of payload, inside mapping
+struct mapped_matrix_t
+{
+  matrix_header_t header;
+  void* base = nullptr;
+  size_t length = 0;
+  const void* data = nullptr;
+};
+
+// Writes `dim` x `dim` matrix to `path`, returns false if it couldn't be
+// written; `layout` only describes how `mat` is laid out, elements are
+// written in same order
+template<typename T>
+bool
+write_matrix(const char* path,
+             const T* mat,
+             const uint dim,
+             const layout_t layout = layout_t::row_major);
+
+// Memory maps matrix file, after validating header & size of payload; no
+// element is read/ copied here, pages are brought in as they're touched
+bool
+map_matrix(const char* path, mapped_matrix_t* const m);
+
+void
+unmap_matrix(mapped_matrix_t* const m);
+
+// Typed view of mapped payload, nullptr if element type doesn't match
+// `dtype` in header
+//
+// Row major payload can be passed to solvers as it's; those which don't
+// rewrite matrix ( `implicit_similarity_transform`, `EigenSolver`,
+// streaming/ multi-device engines ) read/ upload straight out of mapping,
+// without any intermediate copy
+template<typename T>
+const T*
+matrix_data(const mapped_matrix_t& m);
@@ -0,0 +1,18 @@
+#pragma once
+#include <similarity_transform.hpp>
+
+// Working matrix is kept in lower precision storage type `S` ( say
+// `sycl::half` ), halving bytes moved per round, while row sums, eigen vector
+// & eigen value are accumulated/ kept in single precision
+//
+// Input matrix is converted to `S` only once, after that it's never
+// rewritten, as implicit scaling formulation is used
+template<typename S>
+int64_t
+mixed_similarity_transform(sycl::queue& q,
+                           const float* mat,
+                           float* const eigen_val,
+                           float* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count);
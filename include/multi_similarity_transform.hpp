@@ -0,0 +1,50 @@
+#pragma once
+#include <similarity_transform.hpp>
+
+// Creates one queue per NUMA domain of given device, upto `max_parts` many;
+// if device can't be partitioned along NUMA domains ( say it's a GPU or a
+// single socket CPU ), single queue on device itself is returned
+std::vector<sycl::queue>
+make_partition_queues(const sycl::device& d, const uint max_parts);
+
+// Rows of matrix are partitioned across given queues, in blocks of `wg_size`
+// rows, where each queue keeps its own block of rows ( read-only, implicit
+// scaling formulation ) & full copy of eigen vector in its device memory
+//
+// Per round, only dim-length eigen vector ( = cumulative scaling vector ) and
+// few scalars ( local maximum, convergence flag, boundary row sums ) are
+// exchanged among partitions, via host; row sums never leave the partition
+// computing them
+//
+// `dim` must be evenly divisible by `wg_size`, while if there're more queues
+// than `dim / wg_size` row blocks, extra queues are left unused
+template<typename T>
+int64_t
+multi_similarity_transform(std::vector<sycl::queue>& qs,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count);
+
+template<typename T, uint SG = 32>
+sycl::event
+sum_across_scaled_row_block(sycl::queue& q,
+                            const T* mat,
+                            const T* scale_vec,
+                            T* const vec,
+                            const uint rows,
+                            const uint row_offset,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+stop_in_block(sycl::queue& q,
+              const T* vec,
+              uint* const ret,
+              const uint rows,
+              const uint wg_size,
+              std::vector<sycl::event> evts);
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <tolerance.hpp>
+
+// Host only variant of `implicit_similarity_transform`, which doesn't depend
+// on SYCL runtime at all, so that it can be built with any C++17 compiler
+// ( say g++/ clang++ ) & shipped to hosts without oneAPI runtime
+//
+// Rows are split across OpenMP threads ( when built with `-fopenmp`,
+// otherwise it runs on calling thread ), while row sum, rescale, max & stop
+// steps are vectorized using AVX-512 or AVX2 + FMA intrinsics, whichever
+// is enabled at build time ( `-mavx512f` or `-mavx2 -mfma` ), falling back
+// to scalar code otherwise; see `native_simd_isa`
+//
+// Matrix is only read, never rewritten; any `dim` works
+template<typename T>
+int64_t
+native_similarity_transform(const T* mat,
+                            T* const eigen_val,
+                            T* const eigen_vec,
+                            const uint dim,
+                            uint* const iter_count);
+
+// Instruction set native backend was built for, one of
+// "avx512", "avx2" or "scalar"
+const char*
+native_simd_isa();
+
+// Number of threads native backend runs on
+uint
+native_threads();
@@ -1,100 +1,482 @@
 #pragma once
 #include <CL/sycl.hpp>
-
-inline constexpr float EPS = 1e-3;
-inline constexpr uint MAX_ITR = 1000;
+#include <tolerance.hpp>
+#include <type_traits>
 
 typedef std::chrono::_V2::steady_clock::time_point tp;
-typedef sycl::buffer<float, 1> buffer_1d;
-typedef sycl::buffer<float, 2> buffer_2d;
-typedef sycl::accessor<float,
+
+// How convergence is decided, after each round
+//
+// - adjacent: every pair of cyclically adjacent row sums differ by less than
+//   `abs_tol + rel_tol * |row sum|`, which is what `stop` checks
+// - relative_gap: max - min of row sums is at most `abs_tol + rel_tol * max`;
+//   as eigen value lies in [min, max], with `abs_tol` = 0, `rel_tol` bounds
+//   relative error of eigen value, irrespective of scale of matrix
+enum class stop_rule_t
+{
+  adjacent,
+  relative_gap
+};
+
+// Per call tolerances & iteration cap; default ones behave same as
+// `EPS_T<T>`/ `MAX_ITR`
+//
+// With `deadline`, solve stops after last round which could complete before
+// it ( judging by how long previous round took ), returning that round's
+// estimate; bounds ( when asked for ) tell how good it's, while at least one
+// round is always run. Either way, `iter_count` is number of rounds before
+// the one solve stopped after
+template<typename T>
+struct solver_options_t
+{
+  T abs_tol = EPS_T<T>;
+  T rel_tol = T(0);
+  uint max_itr = MAX_ITR;
+  stop_rule_t rule = stop_rule_t::adjacent;
+  tp deadline = tp::max();
+};
+
+template<typename T>
+using buffer_1d_t = sycl::buffer<T, 1>;
+template<typename T>
+using buffer_2d_t = sycl::buffer<T, 2>;
+template<typename T>
+using global_1d_reader_t = sycl::accessor<T,
+                                          1,
+                                          sycl::access::mode::read,
+                                          sycl::access::target::global_buffer>;
+template<typename T>
+using global_2d_reader_t = sycl::accessor<T,
+                                          2,
+                                          sycl::access::mode::read,
+                                          sycl::access::target::global_buffer>;
+template<typename T>
+using global_1d_writer_t = sycl::accessor<T,
+                                          1,
+                                          sycl::access::mode::write,
+                                          sycl::access::target::global_buffer>;
+template<typename T>
+using global_2d_writer_t = sycl::accessor<T,
+                                          2,
+                                          sycl::access::mode::write,
+                                          sycl::access::target::global_buffer>;
+template<typename T>
+using global_1d_reader_writer_t =
+  sycl::accessor<T,
+                 1,
+                 sycl::access::mode::read_write,
+                 sycl::access::target::global_buffer>;
+template<typename T>
+using global_2d_reader_writer_t =
+  sycl::accessor<T,
+                 2,
+                 sycl::access::mode::read_write,
+                 sycl::access::target::global_buffer>;
+template<typename T>
+using local_1d_reader_writer_t = sycl::accessor<T,
+                                                1,
+                                                sycl::access::mode::read_write,
+                                                sycl::access::target::local>;
+
+typedef buffer_1d_t<float> buffer_1d;
+typedef buffer_2d_t<float> buffer_2d;
+typedef global_1d_reader_t<float> global_1d_reader;
+typedef global_2d_reader_t<float> global_2d_reader;
+typedef global_1d_writer_t<float> global_1d_writer;
+typedef global_2d_writer_t<float> global_2d_writer;
+typedef global_1d_reader_writer_t<float> global_1d_reader_writer;
+typedef global_2d_reader_writer_t<float> global_2d_reader_writer;
+typedef local_1d_reader_writer_t<float> local_1d_reader_writer;
+typedef sycl::accessor<uint,
                        1,
                        sycl::access::mode::read,
                        sycl::access::target::global_buffer>
-  global_1d_reader;
-typedef sycl::accessor<float,
-                       2,
-                       sycl::access::mode::read,
-                       sycl::access::target::global_buffer>
-  global_2d_reader;
-typedef sycl::accessor<float,
-                       1,
-                       sycl::access::mode::write,
-                       sycl::access::target::global_buffer>
-  global_1d_writer;
-typedef sycl::accessor<float,
-                       2,
-                       sycl::access::mode::write,
-                       sycl::access::target::global_buffer>
-  global_2d_writer;
-typedef sycl::accessor<float,
+  global_flag_reader;
+typedef sycl::accessor<uint,
                        1,
                        sycl::access::mode::read_write,
                        sycl::access::target::global_buffer>
-  global_1d_reader_writer;
-typedef sycl::accessor<float,
-                       2,
-                       sycl::access::mode::read_write,
-                       sycl::access::target::global_buffer>
-  global_2d_reader_writer;
-typedef sycl::accessor<float,
-                       1,
-                       sycl::access::mode::read_write,
-                       sycl::access::target::local>
-  local_1d_reader_writer;
+  global_flag_reader_writer;
+
+// Picks one of sub-group sizes, kernels are compiled for ( 8, 16 or 32 ),
+// which best matches given device; on CPU that's the one matching SIMD width
+// ( i.e. 8 on AVX2, 16 on AVX-512 ), otherwise largest supported one
+//
+// Returns 0, when device supports none of them, as no kernel can run there
+uint
+sub_group_size(const sycl::device& d);
+
+// Invokes `f` with sub-group size as compile-time constant, so that
+// runtime choice of sub-group size can be turned into kernel instantiation
+//
+// For any other size ( i.e. 0 from `sub_group_size` ), `f` isn't invoked;
+// -1 is returned instead, which is how every engine reports failure
+template<typename F>
+inline auto
+dispatch_sub_group_size(const uint sg_size, F&& f)
+{
+  typedef decltype(f(std::integral_constant<uint, 32>{})) R;
+
+  switch (sg_size) {
+    case 8:
+      return f(std::integral_constant<uint, 8>{});
+    case 16:
+      return f(std::integral_constant<uint, 16>{});
+    case 32:
+      return f(std::integral_constant<uint, 32>{});
+    default:
+      if constexpr (std::is_void_v<R>) {
+        return;
+      } else {
+        return R(-1);
+      }
+  }
+}
+
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     uint* const iter_count);
+
+// Warm started variant, where `init_vec` ( non-null ) is used as initial
+// eigen vector/ cumulative scaling vector, instead of all ones; matrix is
+// pre-scaled with it before first round
+//
+// Final scaling state is what's written to `eigen_vec`, so passing it back
+// in as `init_vec`, when solving slowly changing matrix again, chains solves;
+// `init_vec` may alias `eigen_vec`
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     uint* const iter_count);
+
+// Also writes bounds on eigen value to `bounds` ( non-null ), as [lower,
+// upper] = [min, max] of last round's row sums; `init_vec` may be null
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     T* const bounds,
+                     const uint dim,
+                     const uint wg_size,
+                     uint* const iter_count);
 
+// Same as above, but with non-default tolerances/ stopping rule
+template<typename T>
 int64_t
 similarity_transform(sycl::queue& q,
-                     const float* mat,
-                     float* const eigen_val,
-                     float* const eigen_vec,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     T* const bounds,
                      const uint dim,
                      const uint wg_size,
+                     const solver_options_t<T>& opts,
                      uint* const iter_count);
 
+template<typename T>
+int64_t
+fused_similarity_transform(sycl::queue& q,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count);
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count);
+
+// Warm started variant, same as warm started `similarity_transform`; here
+// initial vector simply becomes first scaling vector
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count);
+
+// Bounds on eigen value, same as in bounds variant of `similarity_transform`
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              T* const bounds,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count);
+
+// Same as above, with options
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              T* const bounds,
+                              const uint dim,
+                              const uint wg_size,
+                              const solver_options_t<T>& opts,
+                              uint* const iter_count);
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              buffer_2d_t<T> mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count);
+
+template<typename T>
+int64_t
+speculative_similarity_transform(sycl::queue& q,
+                                 const T* mat,
+                                 T* const eigen_val,
+                                 T* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 const uint check_interval,
+                                 uint* const iter_count);
+
+// Same as `implicit_similarity_transform`, but every
+// `extrapolation_interval` rounds ( at least 3 ) scaling vector is
+// extrapolated from last three ones, using Aitken's delta-squared process;
+// elements for which extrapolation isn't safe keep latest iterate, so at
+// worst it takes same rounds as non-accelerated one
+template<typename T>
+int64_t
+accelerated_similarity_transform(sycl::queue& q,
+                                 const T* mat,
+                                 T* const eigen_val,
+                                 T* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 const uint extrapolation_interval,
+                                 uint* const iter_count);
+
+template<typename T, uint SG = 32>
 sycl::event
 sum_across_rows(sycl::queue& q,
-                buffer_2d mat,
-                buffer_1d vec,
+                buffer_2d_t<T> mat,
+                buffer_1d_t<T> vec,
                 const uint dim,
                 const uint wg_size,
                 std::vector<sycl::event> evts);
 
+template<typename T, uint SG = 32>
+sycl::event
+sum_across_rows(sycl::queue& q,
+                buffer_2d_t<T> mat,
+                buffer_1d_t<T> vec,
+                sycl::buffer<uint, 1> state,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template<typename S, typename T, uint SG = 32>
+sycl::event
+sum_across_scaled_rows(sycl::queue& q,
+                       sycl::buffer<S, 2> mat,
+                       buffer_1d_t<T> scale_vec,
+                       buffer_1d_t<T> vec,
+                       const uint dim,
+                       const uint wg_size,
+                       std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
 sycl::event
 find_max(sycl::queue& q,
-         buffer_1d vec,
-         buffer_1d max,
+         buffer_1d_t<T> vec,
+         buffer_1d_t<T> max,
          const uint dim,
          const uint wg_size,
          std::vector<sycl::event> evts);
 
+template<typename T, uint SG = 32>
+sycl::event
+compute_eigen_vector(sycl::queue& q,
+                     buffer_1d_t<T> vec,
+                     buffer_1d_t<T> max,
+                     buffer_1d_t<T> eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
 sycl::event
 compute_eigen_vector(sycl::queue& q,
-                     buffer_1d vec,
-                     buffer_1d max,
-                     buffer_1d eigen_vec,
+                     buffer_1d_t<T> vec,
+                     buffer_1d_t<T> max,
+                     buffer_1d_t<T> eigen_vec,
+                     sycl::buffer<uint, 1> state,
                      const uint dim,
                      const uint wg_size,
                      std::vector<sycl::event> evts);
 
+template<typename T>
 sycl::event
 initialise_eigen_vector(sycl::queue& q,
-                        buffer_1d vec,
+                        buffer_1d_t<T> vec,
                         const uint dim,
                         std::vector<sycl::event> evts);
 
+template<typename T, uint SG = 32>
 sycl::event
 compute_next_matrix(sycl::queue& q,
-                    buffer_2d mat,
-                    buffer_1d vec,
+                    buffer_2d_t<T> mat,
+                    buffer_1d_t<T> vec,
                     const uint dim,
                     const uint wg_size,
                     std::vector<sycl::event> evts);
 
+template<typename T, uint SG = 32>
+sycl::event
+compute_next_matrix(sycl::queue& q,
+                    buffer_2d_t<T> mat,
+                    buffer_1d_t<T> vec,
+                    sycl::buffer<uint, 1> state,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+compute_next_matrix_and_sum_rows(sycl::queue& q,
+                                 buffer_2d_t<T> mat,
+                                 buffer_1d_t<T> vec,
+                                 buffer_1d_t<T> next_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
 sycl::event
 stop(sycl::queue& q,
-     buffer_1d vec,
+     buffer_1d_t<T> vec,
      sycl::buffer<uint, 1> ret,
      const uint dim,
      const uint wg_size,
      std::vector<sycl::event> evts);
+
+// Single pass over row sums in `vec`, producing maximum ( `extrema[0]` ),
+// minimum ( `extrema[1]` ) and convergence decision as per `opts` ( in
+// `ret` ), replacing `find_max` & `stop`, along with their fills
+//
+// Reduction is hierarchical: per work group results go to `partials`
+// ( 2 x dim / wg_size ) & `partial_flags` ( dim / wg_size ), which are then
+// reduced by one work group; `dim` must be multiple of `wg_size`
+//
+// For positive matrix, [min, max] of its row sums bounds its dominant
+// eigen value ( Collatz-Wielandt )
+template<typename T, uint SG = 32>
+sycl::event
+reduce_row_sums(sycl::queue& q,
+                buffer_1d_t<T> vec,
+                buffer_1d_t<T> partials,
+                sycl::buffer<uint, 1> partial_flags,
+                buffer_1d_t<T> extrema,
+                sycl::buffer<uint, 1> ret,
+                const uint dim,
+                const uint wg_size,
+                const solver_options_t<T> opts,
+                std::vector<sycl::event> evts);
+
+template<typename T>
+sycl::event
+record_iteration(sycl::queue& q,
+                 buffer_1d_t<T> vec,
+                 sycl::buffer<uint, 1> ret,
+                 sycl::buffer<uint, 1> state,
+                 buffer_1d_t<T> eigen_val,
+                 std::vector<sycl::event> evts);
+
+// Writes element wise Aitken extrapolation of `vec_0`, `vec_1` & `vec_2`
+// ( consecutive iterates ) to `eigen_vec`, keeping `vec_2`'s element where
+// it'd be unsafe
+template<typename T, uint SG = 32>
+sycl::event
+extrapolate_eigen_vector(sycl::queue& q,
+                         buffer_1d_t<T> vec_0,
+                         buffer_1d_t<T> vec_1,
+                         buffer_1d_t<T> vec_2,
+                         buffer_1d_t<T> eigen_vec,
+                         const uint dim,
+                         const uint wg_size,
+                         std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+sum_across_scaled_rows(sycl::queue& q,
+                       const T* mat,
+                       const T* scale_vec,
+                       T* const vec,
+                       const uint dim,
+                       const uint wg_size,
+                       std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+find_max(sycl::queue& q,
+         const T* vec,
+         T* const max,
+         const uint dim,
+         const uint wg_size,
+         std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+compute_eigen_vector(sycl::queue& q,
+                     const T* vec,
+                     const T* max,
+                     T* const eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template<typename T>
+sycl::event
+initialise_eigen_vector(sycl::queue& q,
+                        T* const vec,
+                        const uint dim,
+                        std::vector<sycl::event> evts);
+
+template<typename T, uint SG = 32>
+sycl::event
+stop(sycl::queue& q,
+     const T* vec,
+     uint* const ret,
+     const uint dim,
+     const uint wg_size,
+     std::vector<sycl::event> evts);
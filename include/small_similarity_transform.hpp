@@ -0,0 +1,30 @@
+#pragma once
+#include <matrix_io.hpp>
+#include <tolerance.hpp>
+
+// Compile-time specialised solvers, for dimensions 2 to 8, 16, 32 & 64
+//
+// Each one is instantiated with matrix dimension as template parameter, so
+// that every loop has constant trip count & inner ones are fully unrolled;
+// matrix, eigen vector & row sums are kept on stack ( in registers, for
+// smallest ones ) of calling thread, which runs same rounds as
+// `implicit_similarity_transform`, without any buffer/ kernel launch or
+// host-device synchronization
+//
+// Returns false, without touching anything, when `dim` isn't one of those,
+// otherwise solves & writes time spent ( in microseconds, unlike other
+// engines ) to `ts`
+//
+// Entry points which pick engine by themselves ( autotuned
+// `similarity_transform`, `SolverPool`, C API ) dispatch here first, while
+// ones taking explicit work-group size always launch kernels; those keep
+// returning milliseconds, so solves taken by this path mostly report 0
+template<typename T>
+bool
+small_similarity_transform(const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const layout_t layout,
+                           uint* const iter_count,
+                           int64_t* const ts);
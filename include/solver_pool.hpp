@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <batched_similarity_transform.hpp>
+#include <eigen_solver.hpp>
+#include <memory>
+#include <small_similarity_transform.hpp>
+
+// Bounded, lock-free, multi-producer multi-consumer queue of slot indices
+// ( Vyukov's array based queue ); neither `push` nor `pop` ever blocks,
+// they return false when queue is full/ empty, respectively
+class SlotQueue
+{
+public:
+  // `capacity` is rounded up to next power of 2
+  explicit SlotQueue(const uint capacity);
+
+  bool push(const uint slot);
+  bool pop(uint* const slot);
+
+private:
+  struct cell_t
+  {
+    std::atomic<size_t> seq;
+    uint slot;
+  };
+
+  size_t mask_;
+  std::unique_ptr<cell_t[]> cells_;
+
+  // producers & consumers touch different cache lines
+  alignas(64) std::atomic<size_t> head_{ 0 };
+  alignas(64) std::atomic<size_t> tail_{ 0 };
+};
+
+// Fixed set of solver slots, each one owning its own queue ( on same device
+// & context ) and preallocated `EigenSolver` workspace for matrices upto
+// `max_dim`, which can be shared by any number of threads
+//
+// Free slots are kept in a lock-free queue; a solve pops one, runs on it &
+// pushes it back, while callers finding no free slot wait by spinning
+// ( with yield ), being counted in queue depth meanwhile
+template<typename T>
+class SolverPool
+{
+public:
+  // Throws `std::invalid_argument`, when `slots` is 0
+  SolverPool(const sycl::device& d, const uint slots, const uint max_dim);
+
+  SolverPool(const SolverPool&) = delete;
+  SolverPool& operator=(const SolverPool&) = delete;
+
+  // Blocks calling thread until some slot is free & solve completes on
+  // it; work-group size is picked by autotuner, while fixed small
+  // dimensions are solved on calling thread itself, mostly reporting 0
+  // milliseconds
+  //
+  // Returns -1, without touching anything, if `dim` > `max_dim`
+  int64_t solve(const T* mat,
+                T* const eigen_val,
+                T* const eigen_vec,
+                const uint dim,
+                uint* const iter_count);
+
+  int64_t solve(const T* mat,
+                T* const eigen_val,
+                T* const eigen_vec,
+                const uint dim,
+                const layout_t layout,
+                uint* const iter_count);
+
+  // Solves a contiguous stack of `batch` many row major dim x dim matrices
+  // on one slot, in a single kernel launch ( see
+  // `batched_similarity_transform` ); though slot's preallocated workspace
+  // isn't used, `dim` is still bounded by `max_dim`, returning -1 otherwise,
+  // so that pool accepts same matrices either way
+  int64_t solve_batched(const T* mats,
+                        T* const eigen_vals,
+                        T* const eigen_vecs,
+                        const uint batch,
+                        const uint dim,
+                        uint* const iter_counts);
+
+  uint slots() const { return (uint)solvers_.size(); }
+  uint max_dim() const { return max_dim_; }
+
+  // Callers currently waiting for a free slot
+  uint queue_depth() const { return waiting_.load(); }
+  // Solves currently running
+  uint in_flight() const { return in_flight_.load(); }
+  // Solves completed, since pool was created
+  uint64_t completed() const { return completed_.load(); }
+
+  // Fraction of time, since pool was created, each slot spent solving,
+  // written to `util`, which must have room for `slots()` many
+  void utilization(double* const util) const;
+
+private:
+  // Pops a free slot, waiting for one if none is free
+  uint acquire();
+  // Accounts for time spent on `slot` since `start`, by `solves` many
+  // solves, and makes it free again
+  void release(const uint slot, const tp start, const uint64_t solves);
+
+  const uint max_dim_;
+  std::vector<std::unique_ptr<EigenSolver<T>>> solvers_;
+  // per slot time spent solving, in nanoseconds
+  std::unique_ptr<std::atomic<uint64_t>[]> busy_ns_;
+
+  SlotQueue free_;
+  std::atomic<uint> waiting_{ 0 };
+  std::atomic<uint> in_flight_{ 0 };
+  std::atomic<uint64_t> completed_{ 0 };
+
+  const tp created_;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <similarity_transform.hpp>
+
+typedef sycl::buffer<uint, 1> index_buffer_1d;
+
+// Sparse matrix in compressed sparse row format, with `dim + 1` many row
+// pointers, while column indices and values are `nnz` long
+//
+// Matrix is never rewritten, rather eigen vector is used as cumulative
+// diagonal scaling vector, same as `implicit_similarity_transform`; any
+// `dim` works with any `wg_size`, as dense row sum & eigen vector are
+// padded upto whole work-groups on device
+//
+// Every row must have some positive entry, as a zero row sum ( say of
+// dangling node, in graph ) zeroes that row's scaling factor, which is
+// divided by in next round; -1 is returned, without solving, otherwise
+template<typename T>
+int64_t
+sparse_similarity_transform(sycl::queue& q,
+                            const uint* row_ptr,
+                            const uint* col_idx,
+                            const T* vals,
+                            const uint nnz,
+                            T* const eigen_val,
+                            T* const eigen_vec,
+                            const uint dim,
+                            const uint wg_size,
+                            uint* const iter_count);
+
+// Row sums of implicitly scaled matrix, with global range rounded upto
+// multiple of `wg_size`; `scale_vec` & `vec` must be that long, where
+// elements past `dim` repeat row 0
+template<typename T>
+sycl::event
+sum_across_scaled_sparse_rows(sycl::queue& q,
+                              index_buffer_1d row_ptr,
+                              index_buffer_1d col_idx,
+                              buffer_1d_t<T> vals,
+                              buffer_1d_t<T> scale_vec,
+                              buffer_1d_t<T> vec,
+                              const uint dim,
+                              const uint wg_size,
+                              std::vector<sycl::event> evts);
@@ -0,0 +1,58 @@
+#pragma once
+#include <functional>
+#include <similarity_transform.hpp>
+
+// Fills `tile` with `rows` consecutive rows of matrix ( row major ), starting
+// at row `row_beg`; returns false if those couldn't be read
+template<typename T>
+using tile_reader_t =
+  std::function<bool(T* const tile, const uint row_beg, const uint rows)>;
+
+// Out-of-core variant of `implicit_similarity_transform`, where matrix is
+// never resident in device memory as a whole; instead it's streamed through
+// device in tiles of `tile_rows` rows ( last one may be shorter ), every round
+//
+// Tiles are double-buffered, both in pinned host memory & device memory, so
+// that reading next tile ( from file/ host memory ) and uploading it overlap
+// with computing row sums of current one; device memory requirement is
+// 2 x `tile_rows` x `dim` elements, plus few dim-length vectors
+//
+// `dim` must be evenly divisible by `wg_size` ( which device must support ),
+// while `tile_rows` can be anything in [1, dim]; returns -1, without
+// touching anything, otherwise, and also if some tile couldn't be read
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               tile_reader_t<T> reader,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count);
+
+// Streams tiles out of host resident ( or memory mapped ) matrix
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               const T* mat,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count);
+
+// Streams tiles out of file, holding `dim` x `dim` row major matrix
+// starting at byte `offset`
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               const char* path,
+                               const size_t offset,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count);
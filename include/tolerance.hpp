@@ -0,0 +1,17 @@
+#pragma once
+#include <sys/types.h>
+
+// Kept apart from `similarity_transform.hpp`, so that backends which don't
+// depend on SYCL runtime ( see `native_similarity_transform.hpp` ) stop at
+// same tolerance & round limit
+
+// default absolute tolerance used by stopping criteria, which is why
+// it's kept tighter for double precision
+template<typename T>
+inline constexpr T EPS_T = 1e-3;
+
+template<>
+inline constexpr double EPS_T<double> = 1e-8;
+
+inline constexpr float EPS = EPS_T<float>;
+inline constexpr uint MAX_ITR = 1000;
@@ -38,8 +38,17 @@ stop_criteria_test_fail_data(sycl::queue& q,
                              const uint wg_size,
                              std::vector<sycl::event> evts);
 
+template<typename T>
 void
-generate_random_vector(float* const vec, const uint dim);
+generate_random_vector(T* const vec, const uint dim);
 
+template<typename T>
 void
-generate_hilbert_matrix(sycl::queue& q, float* const mat, const uint dim);
+generate_hilbert_matrix(sycl::queue& q, T* const mat, const uint dim);
+
+void
+generate_random_sparse_matrix(uint* const row_ptr,
+                              uint* const col_idx,
+                              float* const vals,
+                              const uint dim,
+                              const uint nnz_per_row);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <benchmarks.hpp>
 #include <iomanip>
 #include <iostream>
@@ -14,7 +15,16 @@ main()
   const size_t max_wg_size =
     d.get_info<info::device::max_work_group_size>() >> 1;
 
-  std::cout << "running on " << d.get_info<info::device::name>() << "\n"
+  if (sub_group_size(d) == 0) {
+    std::cout << d.get_info<info::device::name>()
+              << " supports none of sub-group sizes 8, 16 & 32, which "
+                 "kernels are compiled for"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << "running on " << d.get_info<info::device::name>()
+            << ", with sub-group size " << sub_group_size(d) << "\n"
             << std::endl;
   std::cout << "Parallel Similarity Transform for finding max "
                "eigen value (with vector)\n"
@@ -24,7 +34,7 @@ main()
     const uint dim = 1ul << i;
 
     uint itr_count = 0;
-    int64_t tm = benchmark_similarity_transform(
+    int64_t tm = benchmark_similarity_transform<float>(
       q, dim, dim <= max_wg_size ? dim : max_wg_size, &itr_count);
 
     std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
@@ -34,6 +44,417 @@ main()
               << " round(s)" << std::endl;
   }
 
+  if (d.has(aspect::fp64)) {
+    std::cout << "\nParallel Similarity Transform, in double precision\n"
+              << std::endl;
+
+    for (uint i = 7; i <= 13; i++) {
+      const uint dim = 1ul << i;
+
+      uint itr_count = 0;
+      int64_t tm = benchmark_similarity_transform<double>(
+        q, dim, dim <= max_wg_size ? dim : max_wg_size, &itr_count);
+
+      std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                << std::right << dim << "\t\t\t" << std::setw(10)
+                << std::right << tm << " ms"
+                << "\t\t\t" << std::setw(6) << std::right << itr_count
+                << " round(s)" << std::endl;
+    }
+  }
+
+  std::cout << "\nParallel Similarity Transform, with autotuned work-group "
+               "size & engine\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+    const char* engines[] = { "plain", "fused", "implicit" };
+
+    tuned_config cfg;
+    uint itr_count = 0;
+    int64_t tm =
+      benchmark_autotuned_similarity_transform(q, dim, &cfg, &itr_count);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)"
+              << "\t\t" << std::setw(4) << std::right << cfg.wg_size << " ( "
+              << engines[(uint)cfg.engine] << " )" << std::endl;
+  }
+
+  std::cout << "\nParallel Similarity Transform, with implicit scaling "
+               "of read-only matrix\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    uint itr_count = 0;
+    int64_t tm = benchmark_implicit_similarity_transform(
+      q, dim, dim <= max_wg_size ? dim : max_wg_size, &itr_count);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)" << std::endl;
+  }
+
+  std::cout << "\nSimilarity Transform of fixed small dimension, latency of "
+               "generic vs. specialised solver\n"
+            << std::endl;
+
+  for (uint dim : { 2u, 3u, 4u, 8u, 16u, 32u, 64u }) {
+    int64_t generic_tm = 0;
+    int64_t tm = benchmark_small_similarity_transform(q, dim, &generic_tm);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << (double)generic_tm * 1e-3 << " us"
+              << "\t\t\t" << std::setw(10) << std::right
+              << (double)tm * 1e-3 << " us" << std::endl;
+  }
+
+  {
+    // side by side with SYCL running on CPU, when there's one
+    std::vector<device> cpus = device::get_devices(info::device_type::cpu);
+    queue cpu_q = cpus.empty() ? q : queue{ cpus[0] };
+    const size_t cpu_wg_size =
+      cpu_q.get_device().get_info<info::device::max_work_group_size>() >> 1;
+
+    std::cout << "\nSimilarity Transform, native backend ( "
+              << native_simd_isa() << ", " << native_threads()
+              << " thread(s) ) vs. SYCL on "
+              << cpu_q.get_device().get_info<info::device::name>() << "\n"
+              << std::endl;
+
+    for (uint i = 7; i <= 13; i++) {
+      const uint dim = 1ul << i;
+
+      int64_t sycl_tm = 0;
+      uint sycl_itr_count = 0;
+      uint itr_count = 0;
+      int64_t tm = benchmark_native_similarity_transform(
+        cpu_q,
+        dim,
+        dim <= cpu_wg_size ? dim : cpu_wg_size,
+        &sycl_tm,
+        &sycl_itr_count,
+        &itr_count);
+
+      std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                << std::right << dim << "\t\t" << std::setw(8) << std::right
+                << sycl_tm << " ms"
+                << "\t" << std::setw(6) << std::right << sycl_itr_count
+                << " round(s) SYCL"
+                << "\t\t" << std::setw(8) << std::right << tm << " ms"
+                << "\t" << std::setw(6) << std::right << itr_count
+                << " round(s) native" << std::endl;
+    }
+  }
+
+  std::cout << "\nParallel Similarity Transform, with many independent "
+               "solves in flight\n"
+            << std::endl;
+
+  for (uint i = 9; i <= 12; i++) {
+    const uint dim = 1ul << i;
+
+    for (uint in_flight : { 1u, 2u, 4u, 8u }) {
+      int64_t tm = benchmark_async_similarity_transform(
+        q, dim, dim <= max_wg_size ? dim : max_wg_size, in_flight);
+
+      std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                << std::right << dim << "\t\t" << std::setw(2) << std::right
+                << in_flight << " in flight"
+                << "\t\t" << std::setw(10) << std::right << tm << " us"
+                << "\t\t" << std::setw(10) << std::right
+                << (tm > 0 ? (double)in_flight * 1e6 / (double)tm : 0.)
+                << " solve(s)/ s" << std::endl;
+    }
+  }
+
+  const std::chrono::milliseconds budget{ 5 };
+  std::cout << "\nParallel Similarity Transform, with deadline of "
+            << budget.count() << " ms\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    float bounds[2] = { 0.f, 0.f };
+    uint itr_count = 0;
+    int64_t tm = benchmark_deadline_similarity_transform(
+      q,
+      dim,
+      dim <= max_wg_size ? dim : max_wg_size,
+      budget,
+      bounds,
+      &itr_count);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)"
+              << "\t\tλ in [ " << bounds[0] << ", " << bounds[1] << " ]"
+              << std::endl;
+  }
+
+  std::cout << "\nParallel Similarity Transform, warm started from previous "
+               "eigen vector, on drifting matrix\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    uint cold_itr_count = 0;
+    uint itr_count = 0;
+    int64_t tm = benchmark_warm_similarity_transform(
+      q, dim, dim <= max_wg_size ? dim : max_wg_size, &cold_itr_count,
+      &itr_count);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)"
+              << "\t\t" << std::setw(6) << std::right << cold_itr_count
+              << " round(s) cold" << std::endl;
+  }
+
+  const uint extrapolation_interval = 4;
+  std::cout << "\nParallel Similarity Transform, with Aitken extrapolation "
+               "every "
+            << extrapolation_interval << " rounds\n"
+            << std::endl;
+
+  {
+    const char* families[] = { "hilbert", "random", "banded" };
+
+    for (const matrix_family_t family : { matrix_family_t::hilbert,
+                                          matrix_family_t::random,
+                                          matrix_family_t::banded }) {
+      for (uint i = 7; i <= 12; i++) {
+        const uint dim = 1ul << i;
+
+        int64_t plain_tm = 0;
+        uint plain_itr_count = 0;
+        uint itr_count = 0;
+        int64_t tm = benchmark_accelerated_similarity_transform(
+          q,
+          dim,
+          dim <= max_wg_size ? dim : max_wg_size,
+          family,
+          extrapolation_interval,
+          &plain_tm,
+          &plain_itr_count,
+          &itr_count);
+
+        std::cout << std::setw(8) << std::left << families[(uint)family]
+                  << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                  << std::right << dim << "\t\t" << std::setw(8)
+                  << std::right << plain_tm << " ms"
+                  << "\t" << std::setw(6) << std::right << plain_itr_count
+                  << " round(s)"
+                  << "\t\t" << std::setw(8) << std::right << tm << " ms"
+                  << "\t" << std::setw(6) << std::right << itr_count
+                  << " round(s) accelerated" << std::endl;
+      }
+    }
+  }
+
+  const uint check_interval = 8;
+  std::cout << "\nParallel Similarity Transform, checking convergence on "
+               "host every "
+            << check_interval << " rounds\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    uint itr_count = 0;
+    int64_t tm = benchmark_speculative_similarity_transform(
+      q,
+      dim,
+      dim <= max_wg_size ? dim : max_wg_size,
+      check_interval,
+      &itr_count);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)" << std::endl;
+  }
+
+  const uint batch = 1u << 12;
+  std::cout << "\nBatched Parallel Similarity Transform, for " << batch
+            << " matrices\n"
+            << std::endl;
+
+  for (uint dim : { 3u, 8u, 16u, 32u, 64u, 128u, 256u }) {
+    int64_t tm = benchmark_batched_similarity_transform(
+      q, batch, dim, dim <= max_wg_size ? dim : max_wg_size);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << (double)tm * 1e-3 << " ms"
+              << "\t\t\t" << std::setw(12) << std::right
+              << (double)batch / ((double)tm * 1e-6) << " matrices/ s"
+              << std::endl;
+  }
+
+  const uint nnz_per_row = 16;
+  std::cout << "\nParallel Similarity Transform, on sparse matrix with "
+            << nnz_per_row << " non-zeros per row\n"
+            << std::endl;
+
+  for (uint i = 16; i <= 22; i++) {
+    const uint dim = 1ul << i;
+
+    uint itr_count = 0;
+    int64_t tm = benchmark_sparse_similarity_transform(
+      q, dim, nnz_per_row, dim <= max_wg_size ? dim : max_wg_size, &itr_count);
+
+    std::cout << std::setw(9) << std::right << dim << "\t\t\t" << std::setw(10)
+              << std::right << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)" << std::endl;
+  }
+
+  {
+    std::vector<queue> qs = make_partition_queues(d, 8);
+
+    std::cout << "\nParallel Similarity Transform, with rows partitioned "
+                 "across upto "
+              << qs.size() << " NUMA domain(s)\n"
+              << std::endl;
+
+    for (uint i = 11; i <= 13; i++) {
+      const uint dim = 1ul << i;
+      // rows are partitioned in blocks of `wg_size`, so there must be at
+      // least as many blocks as queues, otherwise extra ones stay idle
+      uint wg_size = dim <= max_wg_size ? dim : max_wg_size;
+      while (wg_size > 1 && dim / wg_size < qs.size()) {
+        wg_size >>= 1;
+      }
+      int64_t base_tm = 0;
+
+      for (size_t parts = 1; parts <= qs.size(); parts++) {
+        std::vector<queue> qs_{ qs.begin(), qs.begin() + parts };
+
+        uint itr_count = 0;
+        int64_t tm =
+          benchmark_multi_similarity_transform(qs_, dim, wg_size, &itr_count);
+        if (parts == 1) {
+          base_tm = tm;
+        }
+
+        // partitions actually used by engine
+        const size_t used = std::min(parts, (size_t)(dim / wg_size));
+
+        std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                  << std::right << dim << "\t\t" << std::setw(2) << used
+                  << " partition(s)\t\t" << std::setw(10) << std::right << tm
+                  << " ms"
+                  << "\t\t" << std::setw(6) << std::right << itr_count
+                  << " round(s)"
+                  << "\t\t" << std::setw(6) << std::right
+                  << (tm > 0 ? (double)base_tm / (double)tm : 0.) << "x"
+                  << std::endl;
+      }
+    }
+  }
+
+  const uint tile_rows = 256;
+  std::cout << "\nParallel Similarity Transform, streaming matrix through "
+               "device in tiles of "
+            << tile_rows << " rows\n"
+            << std::endl;
+
+  for (uint i = 12; i <= 14; i++) {
+    const uint dim = 1ul << i;
+
+    uint itr_count = 0;
+    int64_t tm = benchmark_streaming_similarity_transform(
+      q, dim, tile_rows, dim <= max_wg_size ? dim : max_wg_size, &itr_count);
+
+    // whole matrix is streamed once per round
+    const double gbs =
+      tm > 0 ? ((double)dim * dim * sizeof(float) * itr_count) /
+                 ((double)tm * 1e6)
+             : 0.;
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms"
+              << "\t\t\t" << std::setw(6) << std::right << itr_count
+              << " round(s)"
+              << "\t\t" << std::setw(8) << std::right << gbs << " GB/s"
+              << std::endl;
+  }
+
+  std::cout << "\nLoading matrix into device memory, memory mapped vs. read "
+               "into host buffer\n"
+            << std::endl;
+
+  for (uint i = 11; i <= 14; i++) {
+    const uint dim = 1ul << i;
+
+    int64_t read_tm = 0;
+    int64_t tm = benchmark_matrix_load(q, dim, &read_tm);
+    if (tm < 0) {
+      std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                << std::right << dim << "\t\t\tfailed to write/ map matrix"
+                << std::endl;
+      continue;
+    }
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << tm << " ms (mmap)"
+              << "\t\t" << std::setw(10) << std::right << read_tm
+              << " ms (read)" << std::endl;
+  }
+
+  for (bool hilbert : { true, false }) {
+    std::cout << "\nParallel Similarity Transform, with half precision "
+                 "matrix storage, on "
+              << (hilbert ? "hilbert" : "random") << " matrix\n"
+              << std::endl;
+
+    for (uint i = 7; i <= 13; i++) {
+      const uint dim = 1ul << i;
+
+      int64_t fp32_tm = 0;
+      float eigen_val_err = 0.f;
+      float eigen_vec_err = 0.f;
+      int64_t tm =
+        benchmark_mixed_similarity_transform(q,
+                                             dim,
+                                             dim <= max_wg_size ? dim
+                                                                : max_wg_size,
+                                             hilbert,
+                                             &fp32_tm,
+                                             &eigen_val_err,
+                                             &eigen_vec_err);
+
+      std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+                << std::right << dim << "\t\t" << std::setw(8) << std::right
+                << fp32_tm << " ms (fp32)"
+                << "\t" << std::setw(8) << std::right << tm << " ms (fp16)"
+                << "\t" << std::setw(6) << std::right
+                << (tm > 0 ? (double)fp32_tm / (double)tm : 0.) << "x"
+                << "\t\tλ error " << std::setw(10) << std::right
+                << eigen_val_err << "\t\tv error " << std::setw(10)
+                << std::right << eigen_vec_err << std::endl;
+    }
+  }
+
   std::cout << "\n[kernel] Sum Across Rows of Matrix (v0)\n" << std::endl;
 
   for (uint i = 7; i <= 13; i++) {
@@ -73,6 +494,19 @@ main()
               << (double)tm * 1e-3 << " ms" << std::endl;
   }
 
+  std::cout << "\n[kernel] Sum Across Rows of Matrix (v3)\n" << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    int64_t tm = benchmark_sum_across_rows_kernel_v3(
+      q, dim, dim <= max_wg_size ? dim : max_wg_size);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << (double)tm * 1e-3 << " ms" << std::endl;
+  }
+
   std::cout << "\n[kernel] Max Value in Vector (v0)\n" << std::endl;
 
   for (uint i = 16; i <= 25; i++) {
@@ -146,6 +580,37 @@ main()
               << (double)tm * 1e-3 << " ms" << std::endl;
   }
 
+  std::cout << "\n[kernel] Next Matrix Computation (v3)\n" << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    int64_t tm = benchmark_compute_next_matrix_v3(
+      q, dim, dim <= max_wg_size ? dim : max_wg_size);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << (double)tm * 1e-3 << " ms" << std::endl;
+  }
+
+  std::cout << "\n[kernel] Next Matrix Computation + Sum Across Rows "
+               "(unfused vs fused)\n"
+            << std::endl;
+
+  for (uint i = 7; i <= 13; i++) {
+    const uint dim = 1ul << i;
+
+    int64_t unfused_tm = 0;
+    int64_t tm = benchmark_fused_next_matrix(
+      q, dim, dim <= max_wg_size ? dim : max_wg_size, &unfused_tm);
+
+    std::cout << std::setw(5) << std::left << dim << "x" << std::setw(5)
+              << std::right << dim << "\t\t\t" << std::setw(10) << std::right
+              << (double)unfused_tm * 1e-3 << " ms"
+              << "\t\t\t" << std::setw(10) << std::right << (double)tm * 1e-3
+              << " ms" << std::endl;
+  }
+
   std::cout << "\n[kernel] Stop Criteria Checker\n" << std::endl;
 
   for (uint i = 16; i <= 25; i++) {
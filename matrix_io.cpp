@@ -0,0 +1,186 @@
+#include "matrix_io.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+template<typename T>
+static dtype_t
+dtype_of();
+
+template<>
+dtype_t
+dtype_of<float>()
+{
+  return dtype_t::f32;
+}
+
+template<>
+dtype_t
+dtype_of<double>()
+{
+  return dtype_t::f64;
+}
+
+template<>
+dtype_t
+dtype_of<sycl::half>()
+{
+  return dtype_t::f16;
+}
+
+static size_t
+dtype_size(const dtype_t dtype)
+{
+  switch (dtype) {
+    case dtype_t::f32:
+      return 4;
+    case dtype_t::f64:
+      return 8;
+    case dtype_t::f16:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+template<typename T>
+bool
+write_matrix(const char* path,
+             const T* mat,
+             const uint dim,
+             const layout_t layout)
+{
+  matrix_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MATRIX_MAGIC, sizeof(header.magic));
+  header.version = MATRIX_VERSION;
+  header.dim = dim;
+  header.dtype = dtype_of<T>();
+  header.layout = layout;
+  header.payload_offset = MATRIX_PAYLOAD_ALIGNMENT;
+
+  std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+  if (!f) {
+    return false;
+  }
+
+  f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // header is followed by zeros, upto beginning of payload
+  const std::vector<char> pad(header.payload_offset - sizeof(header), 0);
+  f.write(pad.data(), pad.size());
+
+  f.write(reinterpret_cast<const char*>(mat), sizeof(T) * dim * dim);
+
+  return f.good();
+}
+
+bool
+map_matrix(const char* path, mapped_matrix_t* const m)
+{
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(matrix_header_t)) {
+    close(fd);
+    return false;
+  }
+
+  const size_t length = st.st_size;
+  void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // mapping stays valid after descriptor is closed
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    return false;
+  }
+
+  matrix_header_t header;
+  memcpy(&header, base, sizeof(header));
+
+  const size_t elm_size = dtype_size(header.dtype);
+
+  // checked with subtraction & division only, so that neither huge offset
+  // nor huge dimension can wrap around & pass as small one
+  const bool valid =
+    memcmp(header.magic, MATRIX_MAGIC, sizeof(header.magic)) == 0 &&
+    header.version == MATRIX_VERSION && elm_size > 0 && header.dim > 0 &&
+    header.layout <= layout_t::col_major &&
+    header.payload_offset % MATRIX_PAYLOAD_ALIGNMENT == 0 &&
+    header.payload_offset >= sizeof(header) &&
+    header.payload_offset <= length &&
+    header.dim <= (length - header.payload_offset) / elm_size / header.dim;
+
+  if (!valid) {
+    munmap(base, length);
+    return false;
+  }
+
+  const size_t payload_len = (size_t)header.dim * header.dim * elm_size;
+
+  // solvers stream through matrix row after row
+  char* data = static_cast<char*>(base) + header.payload_offset;
+  madvise(data, payload_len, MADV_SEQUENTIAL);
+
+  m->header = header;
+  m->base = base;
+  m->length = length;
+  m->data = data;
+
+  return true;
+}
+
+void
+unmap_matrix(mapped_matrix_t* const m)
+{
+  if (m->base != nullptr) {
+    munmap(m->base, m->length);
+  }
+
+  m->base = nullptr;
+  m->length = 0;
+  m->data = nullptr;
+}
+
+template<typename T>
+const T*
+matrix_data(const mapped_matrix_t& m)
+{
+  if (m.data == nullptr || m.header.dtype != dtype_of<T>()) {
+    return nullptr;
+  }
+  return static_cast<const T*>(m.data);
+}
+
+template bool
+write_matrix<float>(const char* path,
+                    const float* mat,
+                    const uint dim,
+                    const layout_t layout);
+
+template bool
+write_matrix<double>(const char* path,
+                     const double* mat,
+                     const uint dim,
+                     const layout_t layout);
+
+template bool
+write_matrix<sycl::half>(const char* path,
+                         const sycl::half* mat,
+                         const uint dim,
+                         const layout_t layout);
+
+template const float*
+matrix_data<float>(const mapped_matrix_t& m);
+
+template const double*
+matrix_data<double>(const mapped_matrix_t& m);
+
+template const sycl::half*
+matrix_data<sycl::half>(const mapped_matrix_t& m);
@@ -0,0 +1,102 @@
+#include "mixed_similarity_transform.hpp"
+#include <chrono>
+
+template<typename S, uint SG>
+static int64_t
+mixed_similarity_transform_impl(sycl::queue& q,
+                                const float* mat,
+                                float* const eigen_val,
+                                float* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                uint* const iter_count)
+{
+  S* mat_ = (S*)malloc(sizeof(S) * dim * dim);
+  float* sum_vec = (float*)malloc(sizeof(float) * dim);
+  float* max_elm = (float*)malloc(sizeof(float) * 1);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  for (size_t i = 0; i < (size_t)dim * dim; i++) {
+    *(mat_ + i) = static_cast<S>(*(mat + i));
+  }
+
+  int64_t ts = 0;
+
+  {
+    sycl::buffer<S, 2> b_mat{ mat_, sycl::range<2>{ dim, dim } };
+    buffer_1d b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
+    buffer_1d b_max_elm{ max_elm, sycl::range<1>{ 1 } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    // matrix is only read from device, don't copy it back
+    b_mat.set_write_back(false);
+
+    initialise_eigen_vector(q, b_eigen_vec, dim, {});
+
+    tp start = std::chrono::steady_clock::now();
+
+    uint i = 0;
+    for (; i < MAX_ITR; i++) {
+      sum_across_scaled_rows<S, float, SG>(
+        q, b_mat, b_eigen_vec, b_sum_vec, dim, wg_size, {});
+      find_max<float, SG>(q, b_sum_vec, b_max_elm, dim, wg_size, {});
+      compute_eigen_vector<float, SG>(
+        q, b_sum_vec, b_max_elm, b_eigen_vec, dim, wg_size, {});
+      stop<float, SG>(q, b_sum_vec, b_ret, dim, wg_size, {});
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
+      global_1d_writer acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    q.wait();
+  }
+
+  std::free(mat_);
+  std::free(sum_vec);
+  std::free(max_elm);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename S>
+int64_t
+mixed_similarity_transform(sycl::queue& q,
+                           const float* mat,
+                           float* const eigen_val,
+                           float* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return mixed_similarity_transform_impl<S, decltype(sg)::value>(
+      q, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+  });
+}
+
+template int64_t
+mixed_similarity_transform<sycl::half>(sycl::queue& q,
+                                       const float* mat,
+                                       float* const eigen_val,
+                                       float* const eigen_vec,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       uint* const iter_count);
@@ -0,0 +1,508 @@
+#include "multi_similarity_transform.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+template<typename T, uint SG>
+class kernelSumAcrossScaledRowBlock;
+
+template<typename T, uint SG>
+class kernelStopInBlock;
+
+// Device memory owned by one partition, along with scalars it reports back
+// to host every round
+template<typename T>
+struct partition_t
+{
+  uint row_offset;
+  uint rows;
+
+  T* mat;       // rows x dim, row major
+  T* eigen_vec; // dim, full copy
+  T* sum_vec;   // rows
+  T* max_elm;   // 1
+  uint* ret;    // 1
+
+  T h_max;
+  T h_first;
+  T h_last;
+  uint h_ret;
+};
+
+std::vector<sycl::queue>
+make_partition_queues(const sycl::device& d, const uint max_parts)
+{
+  std::vector<sycl::device> sub_devs;
+
+  try {
+    sub_devs = d.create_sub_devices<
+      sycl::info::partition_property::partition_by_affinity_domain>(
+      sycl::info::partition_affinity_domain::numa);
+  } catch (const sycl::exception&) {
+    // not partitionable along NUMA domains, whole device it is
+  }
+
+  std::vector<sycl::queue> qs;
+  if (sub_devs.empty()) {
+    qs.emplace_back(d);
+    return qs;
+  }
+
+  for (size_t i = 0; i < sub_devs.size() && i < max_parts; i++) {
+    qs.emplace_back(sub_devs[i]);
+  }
+  return qs;
+}
+
+template<typename T, uint SG>
+static int64_t
+multi_similarity_transform_impl(std::vector<sycl::queue>& qs,
+                                const T* mat,
+                                T* const eigen_val,
+                                T* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                uint* const iter_count)
+{
+  const uint blocks = dim / wg_size;
+  const uint parts = std::min((uint)qs.size(), blocks);
+
+  std::vector<partition_t<T>> ps(parts);
+
+  for (uint p = 0; p < parts; p++) {
+    sycl::queue& q = qs[p];
+    partition_t<T>& pt = ps[p];
+
+    const uint b_beg = (p * blocks) / parts;
+    const uint b_end = ((p + 1) * blocks) / parts;
+
+    pt.row_offset = b_beg * wg_size;
+    pt.rows = (b_end - b_beg) * wg_size;
+
+    // allocated & first written by queue owning partition, so that
+    // memory is placed in partition's own NUMA domain
+    pt.mat = sycl::malloc_device<T>((size_t)pt.rows * dim, q);
+    pt.eigen_vec = sycl::malloc_device<T>(dim, q);
+    pt.sum_vec = sycl::malloc_device<T>(pt.rows, q);
+    pt.max_elm = sycl::malloc_device<T>(1, q);
+    pt.ret = sycl::malloc_device<uint>(1, q);
+
+    q.memcpy(pt.mat,
+             mat + (size_t)pt.row_offset * dim,
+             sizeof(T) * pt.rows * dim);
+    initialise_eigen_vector(q, pt.eigen_vec, dim, {});
+  }
+
+  for (uint p = 0; p < parts; p++) {
+    qs[p].wait();
+  }
+
+  tp start = std::chrono::steady_clock::now();
+
+  uint i = 0;
+  for (; i < MAX_ITR; i++) {
+    // row sums, their maximum & convergence of rows in each partition
+    for (uint p = 0; p < parts; p++) {
+      sycl::queue& q = qs[p];
+      partition_t<T>& pt = ps[p];
+
+      sycl::event evt_0 = sum_across_scaled_row_block<T, SG>(q,
+                                                             pt.mat,
+                                                             pt.eigen_vec,
+                                                             pt.sum_vec,
+                                                             pt.rows,
+                                                             pt.row_offset,
+                                                             dim,
+                                                             wg_size,
+                                                             {});
+      sycl::event evt_1 = find_max<T, SG>(
+        q, pt.sum_vec, pt.max_elm, pt.rows, wg_size, { evt_0 });
+      sycl::event evt_2 = stop_in_block<T, SG>(
+        q, pt.sum_vec, pt.ret, pt.rows, wg_size, { evt_0 });
+
+      q.memcpy(&pt.h_max, pt.max_elm, sizeof(T), evt_1);
+      q.memcpy(&pt.h_ret, pt.ret, sizeof(uint), evt_2);
+      q.memcpy(&pt.h_first, pt.sum_vec, sizeof(T), evt_0);
+      q.memcpy(&pt.h_last, pt.sum_vec + pt.rows - 1, sizeof(T), evt_0);
+    }
+
+    for (uint p = 0; p < parts; p++) {
+      qs[p].wait();
+    }
+
+    // reduction across partitions, where pair of rows at partition
+    // boundary ( cyclic ) is only seen by host
+    T max = T(0);
+    bool converged = true;
+    for (uint p = 0; p < parts; p++) {
+      const partition_t<T>& nxt = ps[(p + 1) % parts];
+
+      max = std::max(max, ps[p].h_max);
+      converged &= ps[p].h_ret == 1;
+      converged &= std::abs(ps[p].h_last - nxt.h_first) < EPS_T<T>;
+    }
+
+    // each partition updates its own block of eigen vector & sends it
+    // to host, where full vector is assembled
+    for (uint p = 0; p < parts; p++) {
+      sycl::queue& q = qs[p];
+      partition_t<T>& pt = ps[p];
+
+      sycl::event evt_3 = q.memcpy(pt.max_elm, &max, sizeof(T));
+      T* const blk_eigen_vec = pt.eigen_vec + pt.row_offset;
+
+      sycl::event evt_4 = compute_eigen_vector<T, SG>(
+        q, pt.sum_vec, pt.max_elm, blk_eigen_vec, pt.rows, wg_size, { evt_3 });
+      q.memcpy(eigen_vec + pt.row_offset,
+               blk_eigen_vec,
+               sizeof(T) * pt.rows,
+               evt_4);
+    }
+
+    for (uint p = 0; p < parts; p++) {
+      qs[p].wait();
+    }
+
+    if (converged) {
+      break;
+    }
+
+    // and sent back to all of them, as next round's scaling vector
+    for (uint p = 0; p < parts; p++) {
+      qs[p].memcpy(ps[p].eigen_vec, eigen_vec, sizeof(T) * dim);
+    }
+
+    for (uint p = 0; p < parts; p++) {
+      qs[p].wait();
+    }
+  }
+  *iter_count = i;
+
+  tp end = std::chrono::steady_clock::now();
+  int64_t ts =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+  // first row sum, of last round, lives in first partition
+  *eigen_val = ps[0].h_first;
+
+  for (uint p = 0; p < parts; p++) {
+    sycl::queue& q = qs[p];
+    partition_t<T>& pt = ps[p];
+
+    sycl::free(pt.mat, q);
+    sycl::free(pt.eigen_vec, q);
+    sycl::free(pt.sum_vec, q);
+    sycl::free(pt.max_elm, q);
+    sycl::free(pt.ret, q);
+  }
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+multi_similarity_transform(std::vector<sycl::queue>& qs,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count)
+{
+  assert(!qs.empty());
+  assert(dim % wg_size == 0);
+
+  // all partitions are of same ( root ) device
+  const uint sg_size = sub_group_size(qs[0].get_device());
+
+  return dispatch_sub_group_size(sg_size, [&](auto sg) {
+    return multi_similarity_transform_impl<T, decltype(sg)::value>(
+      qs, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+  });
+}
+
+template<typename T, uint SG>
+sycl::event
+sum_across_scaled_row_block(sycl::queue& q,
+                            const T* mat,
+                            const T* scale_vec,
+                            T* const vec,
+                            const uint rows,
+                            const uint row_offset,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts)
+{
+  auto evt_0 = q.submit([&](sycl::handler& h) {
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(vec, T(0), rows);
+  });
+
+  auto evt_1 = q.submit([&](sycl::handler& h) {
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.depends_on(evt_0);
+    h.parallel_for<kernelSumAcrossScaledRowBlock<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ rows, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        // row index is local to this block, while scaling vector
+        // is indexed by global row index
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        T loc_sum = sycl::reduce_over_group(
+          sg, mat[r * dim + c] * scale_vec[c], sycl::plus<T>());
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_add(loc_sum);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(vec[r]);
+          ref.fetch_add(lds[0] / scale_vec[row_offset + r]);
+        }
+      });
+  });
+
+  return evt_1;
+}
+
+template<typename T, uint SG>
+sycl::event
+stop_in_block(sycl::queue& q,
+              const T* vec,
+              uint* const ret,
+              const uint rows,
+              const uint wg_size,
+              std::vector<sycl::event> evts)
+{
+  using local_flag_reader_writer =
+    sycl::accessor<uint,
+                   1,
+                   sycl::access::mode::read_write,
+                   sycl::access::target::local>;
+
+  auto evt_0 = q.submit([&](sycl::handler& h) {
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(ret, 1U, 1);
+  });
+
+  auto evt_1 = q.submit([&](sycl::handler& h) {
+    local_flag_reader_writer lds{ sycl::range<1>{ 1 }, h };
+
+    h.depends_on(evt_0);
+    h.parallel_for<kernelStopInBlock<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ rows }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<1> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = 1U;
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t g_id = it.get_global_id(0);
+
+        // unlike `stop`, block isn't cyclic; last row of block is paired
+        // with first row of next block on host, so it's compared with
+        // itself here
+        T self = vec[g_id];
+        T next = sg.shuffle_down(self, 1);
+
+        if (sg.get_local_id()[0] == (sg.get_local_range()[0] - 1)) {
+          next = g_id + 1 < rows ? vec[g_id + 1] : self;
+        }
+
+        T diff = sycl::abs(self - next);
+        bool res = sycl::all_of_group(sg, diff < EPS_T<T>);
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            uint,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref{ lds[0] };
+          ref.fetch_min(res ? 1 : 0);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            uint,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref{ ret[0] };
+          ref.fetch_min(lds[0] ? 1 : 0);
+        }
+      });
+  });
+
+  return evt_1;
+}
+
+template int64_t
+multi_similarity_transform<float>(std::vector<sycl::queue>& qs,
+                                  const float* mat,
+                                  float* const eigen_val,
+                                  float* const eigen_vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  uint* const iter_count);
+
+template int64_t
+multi_similarity_transform<double>(std::vector<sycl::queue>& qs,
+                                   const double* mat,
+                                   double* const eigen_val,
+                                   double* const eigen_vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   uint* const iter_count);
+
+template sycl::event
+sum_across_scaled_row_block<float, 8>(sycl::queue& q,
+                                      const float* mat,
+                                      const float* scale_vec,
+                                      float* const vec,
+                                      const uint rows,
+                                      const uint row_offset,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_row_block<float, 16>(sycl::queue& q,
+                                       const float* mat,
+                                       const float* scale_vec,
+                                       float* const vec,
+                                       const uint rows,
+                                       const uint row_offset,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_row_block<float, 32>(sycl::queue& q,
+                                       const float* mat,
+                                       const float* scale_vec,
+                                       float* const vec,
+                                       const uint rows,
+                                       const uint row_offset,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_row_block<double, 8>(sycl::queue& q,
+                                       const double* mat,
+                                       const double* scale_vec,
+                                       double* const vec,
+                                       const uint rows,
+                                       const uint row_offset,
+                                       const uint dim,
+                                       const uint wg_size,
+                                       std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_row_block<double, 16>(sycl::queue& q,
+                                        const double* mat,
+                                        const double* scale_vec,
+                                        double* const vec,
+                                        const uint rows,
+                                        const uint row_offset,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_row_block<double, 32>(sycl::queue& q,
+                                        const double* mat,
+                                        const double* scale_vec,
+                                        double* const vec,
+                                        const uint rows,
+                                        const uint row_offset,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<float, 8>(sycl::queue& q,
+                        const float* vec,
+                        uint* const ret,
+                        const uint rows,
+                        const uint wg_size,
+                        std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<float, 16>(sycl::queue& q,
+                         const float* vec,
+                         uint* const ret,
+                         const uint rows,
+                         const uint wg_size,
+                         std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<float, 32>(sycl::queue& q,
+                         const float* vec,
+                         uint* const ret,
+                         const uint rows,
+                         const uint wg_size,
+                         std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<double, 8>(sycl::queue& q,
+                         const double* vec,
+                         uint* const ret,
+                         const uint rows,
+                         const uint wg_size,
+                         std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<double, 16>(sycl::queue& q,
+                          const double* vec,
+                          uint* const ret,
+                          const uint rows,
+                          const uint wg_size,
+                          std::vector<sycl::event> evts);
+
+template sycl::event
+stop_in_block<double, 32>(sycl::queue& q,
+                          const double* vec,
+                          uint* const ret,
+                          const uint rows,
+                          const uint wg_size,
+                          std::vector<sycl::event> evts);
@@ -0,0 +1,324 @@
+#include "native_similarity_transform.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Thin wrapper over SIMD registers of instruction set chosen at build time;
+// primary template is one lane wide, so that same kernels are compiled
+// into scalar code, when neither AVX-512 nor AVX2 is enabled
+template<typename T>
+struct simd
+{
+  typedef T reg;
+  static constexpr uint W = 1;
+
+  static reg load(const T* p) { return *p; }
+  static void store(T* const p, const reg v) { *p = v; }
+  static reg set1(const T v) { return v; }
+  static reg add(const reg a, const reg b) { return a + b; }
+  static reg mul(const reg a, const reg b) { return a * b; }
+  static reg div(const reg a, const reg b) { return a / b; }
+  static reg fmadd(const reg a, const reg b, const reg c) { return a * b + c; }
+  static T hsum(const reg v) { return v; }
+  // every lane of `a` is within `eps` of respective lane of `b`
+  static bool all_close(const reg a, const reg b, const reg eps)
+  {
+    return std::abs(a - b) < eps;
+  }
+};
+
+#if defined(__AVX512F__)
+
+static constexpr const char* ISA = "avx512";
+
+template<>
+struct simd<float>
+{
+  typedef __m512 reg;
+  static constexpr uint W = 16;
+
+  static reg load(const float* p) { return _mm512_loadu_ps(p); }
+  static void store(float* const p, const reg v) { _mm512_storeu_ps(p, v); }
+  static reg set1(const float v) { return _mm512_set1_ps(v); }
+  static reg add(const reg a, const reg b) { return _mm512_add_ps(a, b); }
+  static reg mul(const reg a, const reg b) { return _mm512_mul_ps(a, b); }
+  static reg div(const reg a, const reg b) { return _mm512_div_ps(a, b); }
+  static reg fmadd(const reg a, const reg b, const reg c)
+  {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+  static float hsum(const reg v)
+  {
+    // once per row, so spilling lanes costs nothing noticeable
+    alignas(64) float lanes[W];
+    _mm512_store_ps(lanes, v);
+
+    float sum = 0.f;
+    for (uint i = 0; i < W; i++) {
+      sum += lanes[i];
+    }
+    return sum;
+  }
+  static bool all_close(const reg a, const reg b, const reg eps)
+  {
+    const reg diff = _mm512_abs_ps(_mm512_sub_ps(a, b));
+    return _mm512_cmp_ps_mask(diff, eps, _CMP_LT_OQ) == 0xffff;
+  }
+};
+
+template<>
+struct simd<double>
+{
+  typedef __m512d reg;
+  static constexpr uint W = 8;
+
+  static reg load(const double* p) { return _mm512_loadu_pd(p); }
+  static void store(double* const p, const reg v) { _mm512_storeu_pd(p, v); }
+  static reg set1(const double v) { return _mm512_set1_pd(v); }
+  static reg add(const reg a, const reg b) { return _mm512_add_pd(a, b); }
+  static reg mul(const reg a, const reg b) { return _mm512_mul_pd(a, b); }
+  static reg div(const reg a, const reg b) { return _mm512_div_pd(a, b); }
+  static reg fmadd(const reg a, const reg b, const reg c)
+  {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+  static double hsum(const reg v)
+  {
+    alignas(64) double lanes[W];
+    _mm512_store_pd(lanes, v);
+
+    double sum = 0.;
+    for (uint i = 0; i < W; i++) {
+      sum += lanes[i];
+    }
+    return sum;
+  }
+  static bool all_close(const reg a, const reg b, const reg eps)
+  {
+    const reg diff = _mm512_abs_pd(_mm512_sub_pd(a, b));
+    return _mm512_cmp_pd_mask(diff, eps, _CMP_LT_OQ) == 0xff;
+  }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+static constexpr const char* ISA = "avx2";
+
+template<>
+struct simd<float>
+{
+  typedef __m256 reg;
+  static constexpr uint W = 8;
+
+  static reg load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* const p, const reg v) { _mm256_storeu_ps(p, v); }
+  static reg set1(const float v) { return _mm256_set1_ps(v); }
+  static reg add(const reg a, const reg b) { return _mm256_add_ps(a, b); }
+  static reg mul(const reg a, const reg b) { return _mm256_mul_ps(a, b); }
+  static reg div(const reg a, const reg b) { return _mm256_div_ps(a, b); }
+  static reg fmadd(const reg a, const reg b, const reg c)
+  {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  static float hsum(const reg v)
+  {
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v),
+                           _mm256_extractf128_ps(v, 1));
+    lo = _mm_hadd_ps(lo, lo);
+    lo = _mm_hadd_ps(lo, lo);
+    return _mm_cvtss_f32(lo);
+  }
+  static bool all_close(const reg a, const reg b, const reg eps)
+  {
+    // clearing sign bit gives absolute value
+    const reg diff =
+      _mm256_andnot_ps(_mm256_set1_ps(-0.f), _mm256_sub_ps(a, b));
+    return _mm256_movemask_ps(_mm256_cmp_ps(diff, eps, _CMP_LT_OQ)) == 0xff;
+  }
+};
+
+template<>
+struct simd<double>
+{
+  typedef __m256d reg;
+  static constexpr uint W = 4;
+
+  static reg load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* const p, const reg v) { _mm256_storeu_pd(p, v); }
+  static reg set1(const double v) { return _mm256_set1_pd(v); }
+  static reg add(const reg a, const reg b) { return _mm256_add_pd(a, b); }
+  static reg mul(const reg a, const reg b) { return _mm256_mul_pd(a, b); }
+  static reg div(const reg a, const reg b) { return _mm256_div_pd(a, b); }
+  static reg fmadd(const reg a, const reg b, const reg c)
+  {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+  static double hsum(const reg v)
+  {
+    __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v),
+                            _mm256_extractf128_pd(v, 1));
+    lo = _mm_add_sd(lo, _mm_unpackhi_pd(lo, lo));
+    return _mm_cvtsd_f64(lo);
+  }
+  static bool all_close(const reg a, const reg b, const reg eps)
+  {
+    const reg diff =
+      _mm256_andnot_pd(_mm256_set1_pd(-0.), _mm256_sub_pd(a, b));
+    return _mm256_movemask_pd(_mm256_cmp_pd(diff, eps, _CMP_LT_OQ)) == 0xf;
+  }
+};
+
+#else
+
+static constexpr const char* ISA = "scalar";
+
+#endif
+
+// Dot product of matrix row with ( scaling ) vector, which is row sum of
+// implicitly scaled matrix, before being divided by `vec[r]`
+template<typename T>
+static inline T
+row_sum(const T* row, const T* vec, const uint dim)
+{
+  typedef simd<T> V;
+
+  // two independent accumulators, so that consecutive FMAs don't wait
+  // on each other
+  typename V::reg acc_0 = V::set1(T(0));
+  typename V::reg acc_1 = V::set1(T(0));
+
+  uint c = 0;
+  for (; c + 2 * V::W <= dim; c += 2 * V::W) {
+    acc_0 = V::fmadd(V::load(row + c), V::load(vec + c), acc_0);
+    acc_1 = V::fmadd(V::load(row + c + V::W), V::load(vec + c + V::W), acc_1);
+  }
+  for (; c + V::W <= dim; c += V::W) {
+    acc_0 = V::fmadd(V::load(row + c), V::load(vec + c), acc_0);
+  }
+
+  T sum = V::hsum(V::add(acc_0, acc_1));
+  for (; c < dim; c++) {
+    sum += row[c] * vec[c];
+  }
+
+  return sum;
+}
+
+template<typename T>
+int64_t
+native_similarity_transform(const T* mat,
+                            T* const eigen_val,
+                            T* const eigen_vec,
+                            const uint dim,
+                            uint* const iter_count)
+{
+  typedef simd<T> V;
+
+  T* sum_vec = (T*)malloc(sizeof(T) * dim);
+
+  for (uint r = 0; r < dim; r++) {
+    eigen_vec[r] = T(1);
+  }
+
+  // last row is compared with first one, so it's left out of vector
+  // blocks & checked along with remaining tail
+  const uint blocks = (dim - 1) / V::W;
+  const uint tail = blocks * V::W;
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  uint i = 0;
+  for (; i < MAX_ITR; i++) {
+    T max_sum = T(0);
+
+    // row sums of D^-1 A D, where D is diagonal of eigen vector; max is
+    // taken here itself, it's just one comparison per row
+#pragma omp parallel for schedule(static) reduction(max : max_sum)
+    for (uint r = 0; r < dim; r++) {
+      const T sum =
+        row_sum(mat + (size_t)r * dim, eigen_vec, dim) / eigen_vec[r];
+
+      sum_vec[r] = sum;
+      max_sum = std::max(max_sum, sum);
+    }
+
+    // rescale eigen vector & check whether cyclically adjacent row sums
+    // are close enough, in same pass over row sums
+    const typename V::reg v_max = V::set1(max_sum);
+    const typename V::reg v_eps = V::set1(EPS_T<T>);
+
+    bool res = true;
+
+#pragma omp parallel for schedule(static) reduction(&& : res)
+    for (uint b = 0; b < blocks; b++) {
+      const uint r = b * V::W;
+
+      const typename V::reg sum = V::load(sum_vec + r);
+      const typename V::reg next = V::load(sum_vec + r + 1);
+      const typename V::reg vec = V::load(eigen_vec + r);
+
+      V::store(eigen_vec + r, V::mul(vec, V::div(sum, v_max)));
+      res = res && V::all_close(sum, next, v_eps);
+    }
+
+    for (uint r = tail; r < dim; r++) {
+      eigen_vec[r] *= (sum_vec[r] / max_sum);
+      res = res && std::abs(sum_vec[r] - sum_vec[(r + 1) % dim]) < EPS_T<T>;
+    }
+
+    if (res) {
+      break;
+    }
+  }
+  *iter_count = i;
+
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  int64_t ts =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+  *eigen_val = sum_vec[0];
+
+  std::free(sum_vec);
+
+  return ts;
+}
+
+const char*
+native_simd_isa()
+{
+  return ISA;
+}
+
+uint
+native_threads()
+{
+#ifdef _OPENMP
+  return (uint)omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+template int64_t
+native_similarity_transform<float>(const float* mat,
+                                   float* const eigen_val,
+                                   float* const eigen_vec,
+                                   const uint dim,
+                                   uint* const iter_count);
+
+template int64_t
+native_similarity_transform<double>(const double* mat,
+                                    double* const eigen_val,
+                                    double* const eigen_vec,
+                                    const uint dim,
+                                    uint* const iter_count);
@@ -1,129 +1,1846 @@
 #include "similarity_transform.hpp"
+#include <algorithm>
 #include <chrono>
 #include <limits>
 
+template<typename T, uint SG>
+class kernelSumAcrossAllRows;
+
+template<typename T, uint SG>
+class kernelGuardedSumAcrossAllRows;
+
+template<typename S, typename T, uint SG>
+class kernelSumAcrossAllScaledRows;
+
+template<typename T, uint SG>
+class kernelMaxInVector;
+
+template<typename T, uint SG>
+class kernelComputeEigenVector;
+
+template<typename T, uint SG>
+class kernelGuardedComputeEigenVector;
+
+template<typename T, uint SG>
+class kernelSimilarityTransform;
+
+template<typename T, uint SG>
+class kernelGuardedSimilarityTransform;
+
+template<typename T, uint SG>
+class kernelFusedSimilarityTransform;
+
+template<typename T, uint SG>
+class kernelStopCriteria;
+
+template<typename T, uint SG>
+class kernelReduceRowSums;
+
+template<typename T, uint SG>
+class kernelReduceRowSumsFinal;
+
+template<typename T>
+class kernelRecordIteration;
+
+template<typename T, uint SG>
+class kernelExtrapolateEigenVector;
+
+template<typename T, uint SG>
+class kernelSumAcrossAllScaledRowsUSM;
+
+template<typename T, uint SG>
+class kernelMaxInVectorUSM;
+
+template<typename T, uint SG>
+class kernelComputeEigenVectorUSM;
+
+template<typename T, uint SG>
+class kernelStopCriteriaUSM;
+
+uint
+sub_group_size(const sycl::device& d)
+{
+  const std::vector<size_t> sizes =
+    d.get_info<sycl::info::device::sub_group_sizes>();
+
+  // on CPU, one work item maps to one SIMD lane, so sub-group should
+  // be as wide as native vector register
+  size_t want = 32;
+  if (d.is_cpu()) {
+    want = d.get_info<sycl::info::device::native_vector_width_float>();
+  }
+
+  uint best = 0;
+  for (const uint sg_size : { 8u, 16u, 32u }) {
+    const bool supported =
+      std::find(sizes.begin(), sizes.end(), sg_size) != sizes.end();
+    if (supported && (sg_size <= want || best == 0)) {
+      best = sg_size;
+    }
+  }
+
+  return best;
+}
+
+// Whether another round, taking as long as one which started at
+// `round_start` & has just completed, would finish after `deadline`
+static bool
+next_round_misses(const tp deadline, const tp round_start)
+{
+  const tp now = std::chrono::steady_clock::now();
+  // not `now + (now - round_start)`, which overflows for no deadline
+  return deadline - now < now - round_start;
+}
+
+template<typename T, uint SG>
+static int64_t
+similarity_transform_impl(sycl::queue& q,
+                          const T* mat,
+                          T* const eigen_val,
+                          T* const eigen_vec,
+                          const T* init_vec,
+                          T* const bounds,
+                          const uint dim,
+                          const uint wg_size,
+                          const solver_options_t<T>& opts,
+                          uint* const iter_count)
+{
+  T* mat_ = (T*)malloc(sizeof(T) * dim * dim);
+  T* sum_vec = (T*)malloc(sizeof(T) * dim);
+  // [0] = max, [1] = min of row sums
+  T* extrema = (T*)malloc(sizeof(T) * 2);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  memcpy(mat_, mat, sizeof(T) * dim * dim);
+  // previous solve's result can be passed back in as `eigen_vec` itself
+  if (init_vec != nullptr && init_vec != eigen_vec) {
+    memcpy(eigen_vec, init_vec, sizeof(T) * dim);
+  }
+  int64_t ts = 0;
+
+  // just to automatically destroy buffers
+  // putting in different scope, so that following
+  // std::free doesn't segfault !
+  {
+    buffer_2d_t<T> b_mat{ mat_, sycl::range<2>{ dim, dim } };
+    buffer_1d_t<T> b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d_t<T> b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_extrema{ extrema, sycl::range<1>{ 2 } };
+    buffer_1d_t<T> b_partials{ sycl::range<1>{ 2 * (dim / wg_size) } };
+    sycl::buffer<uint, 1> b_partial_flags{ sycl::range<1>{ dim / wg_size } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    if (init_vec == nullptr) {
+      initialise_eigen_vector(q, b_eigen_vec, dim, {});
+    }
+
+    tp start = std::chrono::steady_clock::now();
+
+    // warm start: matrix is brought to D^-1 . A . D, with D = diag(initial
+    // vector), in one go, which is what many rounds would have done, when
+    // initial vector is close to eigen vector
+    if (init_vec != nullptr) {
+      compute_next_matrix<T, SG>(q, b_mat, b_eigen_vec, dim, wg_size, {});
+    }
+
+    uint i = 0;
+    for (; i < opts.max_itr; i++) {
+      const tp round_start = std::chrono::steady_clock::now();
+
+      sum_across_rows<T, SG>(q, b_mat, b_sum_vec, dim, wg_size, {});
+      reduce_row_sums<T, SG>(q,
+                             b_sum_vec,
+                             b_partials,
+                             b_partial_flags,
+                             b_extrema,
+                             b_ret,
+                             dim,
+                             wg_size,
+                             opts,
+                             {});
+      compute_eigen_vector<T, SG>(
+        q, b_sum_vec, b_extrema, b_eigen_vec, dim, wg_size, {});
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+
+      // rather than starting round which can't complete in time, stop
+      // with estimate & bounds of this one; like on convergence, round
+      // which solve stops after isn't counted in `iter_count`
+      if (next_round_misses(opts.deadline, round_start)) {
+        break;
+      }
+
+      compute_next_matrix<T, SG>(q, b_mat, b_sum_vec, dim, wg_size, {});
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
+      global_1d_writer_t<T> acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    q.wait();
+
+    if (bounds != nullptr) {
+      sycl::host_accessor<T, 1, sycl::access_mode::read> h_extrema{
+        b_extrema
+      };
+      bounds[0] = h_extrema[1];
+      bounds[1] = h_extrema[0];
+    }
+  }
+
+  std::free(mat_);
+  std::free(sum_vec);
+  std::free(extrema);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     uint* const iter_count)
+{
+  return similarity_transform<T>(
+    q, mat, eigen_val, eigen_vec, nullptr, dim, wg_size, iter_count);
+}
+
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     uint* const iter_count)
+{
+  return similarity_transform<T>(
+    q, mat, eigen_val, eigen_vec, init_vec, nullptr, dim, wg_size, iter_count);
+}
+
+template<typename T>
 int64_t
 similarity_transform(sycl::queue& q,
-                     const float* mat,
-                     float* const eigen_val,
-                     float* const eigen_vec,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     T* const bounds,
                      const uint dim,
                      const uint wg_size,
                      uint* const iter_count)
 {
-  float* mat_ = (float*)malloc(sizeof(float) * dim * dim);
-  float* sum_vec = (float*)malloc(sizeof(float) * dim);
-  float* max_elm = (float*)malloc(sizeof(float) * 1);
+  return similarity_transform<T>(q,
+                                 mat,
+                                 eigen_val,
+                                 eigen_vec,
+                                 init_vec,
+                                 bounds,
+                                 dim,
+                                 wg_size,
+                                 solver_options_t<T>{},
+                                 iter_count);
+}
+
+template<typename T>
+int64_t
+similarity_transform(sycl::queue& q,
+                     const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const T* init_vec,
+                     T* const bounds,
+                     const uint dim,
+                     const uint wg_size,
+                     const solver_options_t<T>& opts,
+                     uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return similarity_transform_impl<T, decltype(sg)::value>(q,
+                                                             mat,
+                                                             eigen_val,
+                                                             eigen_vec,
+                                                             init_vec,
+                                                             bounds,
+                                                             dim,
+                                                             wg_size,
+                                                             opts,
+                                                             iter_count);
+  });
+}
+
+template<typename T, uint SG>
+static int64_t
+fused_similarity_transform_impl(sycl::queue& q,
+                                const T* mat,
+                                T* const eigen_val,
+                                T* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                uint* const iter_count)
+{
+  T* mat_ = (T*)malloc(sizeof(T) * dim * dim);
+  T* sum_vec_0 = (T*)malloc(sizeof(T) * dim);
+  T* sum_vec_1 = (T*)malloc(sizeof(T) * dim);
+  // [0] = max, [1] = min of row sums
+  T* extrema = (T*)malloc(sizeof(T) * 2);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  memcpy(mat_, mat, sizeof(T) * dim * dim);
+  int64_t ts = 0;
+
+  {
+    buffer_2d_t<T> b_mat{ mat_, sycl::range<2>{ dim, dim } };
+    buffer_1d_t<T> b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    // row sums of current matrix live in one of these buffers, while
+    // fused kernel writes row sums of next matrix into other one
+    buffer_1d_t<T> b_sum_vec[2] = {
+      buffer_1d_t<T>{ sum_vec_0, sycl::range<1>{ dim } },
+      buffer_1d_t<T>{ sum_vec_1, sycl::range<1>{ dim } }
+    };
+    buffer_1d_t<T> b_extrema{ extrema, sycl::range<1>{ 2 } };
+    buffer_1d_t<T> b_partials{ sycl::range<1>{ 2 * (dim / wg_size) } };
+    sycl::buffer<uint, 1> b_partial_flags{ sycl::range<1>{ dim / wg_size } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    initialise_eigen_vector(q, b_eigen_vec, dim, {});
+
+    tp start = std::chrono::steady_clock::now();
+
+    // only time whole matrix is read just for computing row sums,
+    // afterwards row sums come out of fused rescaling kernel
+    sum_across_rows<T, SG>(q, b_mat, b_sum_vec[0], dim, wg_size, {});
+
+    const solver_options_t<T> opts{};
+
+    uint i = 0;
+    for (; i < MAX_ITR; i++) {
+      buffer_1d_t<T> b_cur = b_sum_vec[i & 1];
+      buffer_1d_t<T> b_nxt = b_sum_vec[(i + 1) & 1];
+
+      reduce_row_sums<T, SG>(q,
+                             b_cur,
+                             b_partials,
+                             b_partial_flags,
+                             b_extrema,
+                             b_ret,
+                             dim,
+                             wg_size,
+                             opts,
+                             {});
+      compute_eigen_vector<T, SG>(
+        q, b_cur, b_extrema, b_eigen_vec, dim, wg_size, {});
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+
+      compute_next_matrix_and_sum_rows<T, SG>(
+        q, b_mat, b_cur, b_nxt, dim, wg_size, {});
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_sum_vec{
+        b_sum_vec[i & 1], h, sycl::range<1>{ 1 }
+      };
+      global_1d_writer_t<T> acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    q.wait();
+  }
+
+  std::free(mat_);
+  std::free(sum_vec_0);
+  std::free(sum_vec_1);
+  std::free(extrema);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+fused_similarity_transform(sycl::queue& q,
+                           const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const uint wg_size,
+                           uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return fused_similarity_transform_impl<T, decltype(sg)::value>(
+      q, mat, eigen_val, eigen_vec, dim, wg_size, iter_count);
+  });
+}
+
+template<typename T, uint SG>
+static int64_t
+implicit_similarity_transform_impl(sycl::queue& q,
+                                   buffer_2d_t<T> mat,
+                                   T* const eigen_val,
+                                   T* const eigen_vec,
+                                   const T* init_vec,
+                                   T* const bounds,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   const solver_options_t<T>& opts,
+                                   uint* const iter_count);
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count)
+{
+  return implicit_similarity_transform<T>(
+    q, mat, eigen_val, eigen_vec, nullptr, dim, wg_size, iter_count);
+}
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count)
+{
+  return implicit_similarity_transform<T>(
+    q, mat, eigen_val, eigen_vec, init_vec, nullptr, dim, wg_size, iter_count);
+}
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              T* const bounds,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count)
+{
+  return implicit_similarity_transform<T>(q,
+                                          mat,
+                                          eigen_val,
+                                          eigen_vec,
+                                          init_vec,
+                                          bounds,
+                                          dim,
+                                          wg_size,
+                                          solver_options_t<T>{},
+                                          iter_count);
+}
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              const T* mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const T* init_vec,
+                              T* const bounds,
+                              const uint dim,
+                              const uint wg_size,
+                              const solver_options_t<T>& opts,
+                              uint* const iter_count)
+{
+  int64_t ts = 0;
+
+  {
+    // buffer is constructed over read-only host data, so no
+    // copy of input matrix is made and nothing is written back
+    buffer_2d_t<T> b_mat{ mat, sycl::range<2>{ dim, dim } };
+
+    ts =
+      dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+        return implicit_similarity_transform_impl<T, decltype(sg)::value>(
+          q,
+          b_mat,
+          eigen_val,
+          eigen_vec,
+          init_vec,
+          bounds,
+          dim,
+          wg_size,
+          opts,
+          iter_count);
+      });
+  }
+
+  return ts;
+}
+
+template<typename T, uint SG>
+static int64_t
+implicit_similarity_transform_impl(sycl::queue& q,
+                                   buffer_2d_t<T> mat,
+                                   T* const eigen_val,
+                                   T* const eigen_vec,
+                                   const T* init_vec,
+                                   T* const bounds,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   const solver_options_t<T>& opts,
+                                   uint* const iter_count)
+{
+  T* sum_vec = (T*)malloc(sizeof(T) * dim);
+  // [0] = max, [1] = min of row sums
+  T* extrema = (T*)malloc(sizeof(T) * 2);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  if (init_vec != nullptr && init_vec != eigen_vec) {
+    memcpy(eigen_vec, init_vec, sizeof(T) * dim);
+  }
+  int64_t ts = 0;
+
+  {
+    buffer_1d_t<T> b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d_t<T> b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_extrema{ extrema, sycl::range<1>{ 2 } };
+    buffer_1d_t<T> b_partials{ sycl::range<1>{ 2 * (dim / wg_size) } };
+    sycl::buffer<uint, 1> b_partial_flags{ sycl::range<1>{ dim / wg_size } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    // when warm started, initial vector already is the scaling vector
+    // to start with, nothing to pre-scale
+    if (init_vec == nullptr) {
+      initialise_eigen_vector(q, b_eigen_vec, dim, {});
+    }
+
+    tp start = std::chrono::steady_clock::now();
+
+    // matrix at round k is D^-1 . A . D, where D = diag(eigen vector),
+    // which is why eigen vector itself is used as cumulative scaling
+    // vector, while input matrix is never written to
+    uint i = 0;
+    for (; i < opts.max_itr; i++) {
+      const tp round_start = std::chrono::steady_clock::now();
+
+      sum_across_scaled_rows<T, T, SG>(
+        q, mat, b_eigen_vec, b_sum_vec, dim, wg_size, {});
+      reduce_row_sums<T, SG>(q,
+                             b_sum_vec,
+                             b_partials,
+                             b_partial_flags,
+                             b_extrema,
+                             b_ret,
+                             dim,
+                             wg_size,
+                             opts,
+                             {});
+      compute_eigen_vector<T, SG>(
+        q, b_sum_vec, b_extrema, b_eigen_vec, dim, wg_size, {});
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+
+      if (next_round_misses(opts.deadline, round_start)) {
+        break;
+      }
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    // waiting only for own work, as queue may be shared with other
+    // in-flight solves
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
+      global_1d_writer_t<T> acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    evt.wait();
+
+    if (bounds != nullptr) {
+      sycl::host_accessor<T, 1, sycl::access_mode::read> h_extrema{
+        b_extrema
+      };
+      bounds[0] = h_extrema[1];
+      bounds[1] = h_extrema[0];
+    }
+  }
+
+  std::free(sum_vec);
+  std::free(extrema);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+implicit_similarity_transform(sycl::queue& q,
+                              buffer_2d_t<T> mat,
+                              T* const eigen_val,
+                              T* const eigen_vec,
+                              const uint dim,
+                              const uint wg_size,
+                              uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return implicit_similarity_transform_impl<T, decltype(sg)::value>(
+      q,
+      mat,
+      eigen_val,
+      eigen_vec,
+      nullptr,
+      nullptr,
+      dim,
+      wg_size,
+      solver_options_t<T>{},
+      iter_count);
+  });
+}
+
+template<typename T, uint SG>
+static int64_t
+speculative_similarity_transform_impl(sycl::queue& q,
+                                      const T* mat,
+                                      T* const eigen_val,
+                                      T* const eigen_vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      const uint check_interval,
+                                      uint* const iter_count)
+{
+  T* mat_ = (T*)malloc(sizeof(T) * dim * dim);
+  T* sum_vec = (T*)malloc(sizeof(T) * dim);
+  // [0] = max, [1] = min of row sums
+  T* extrema = (T*)malloc(sizeof(T) * 2);
   uint* ret = (uint*)malloc(sizeof(uint) * 1);
+  // [0] = converged ?, [1] = iteration count
+  uint* state = (uint*)malloc(sizeof(uint) * 2);
+
+  memcpy(mat_, mat, sizeof(T) * dim * dim);
+  memset(state, 0, sizeof(uint) * 2);
+  int64_t ts = 0;
+
+  {
+    buffer_2d_t<T> b_mat{ mat_, sycl::range<2>{ dim, dim } };
+    buffer_1d_t<T> b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d_t<T> b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_extrema{ extrema, sycl::range<1>{ 2 } };
+    buffer_1d_t<T> b_partials{ sycl::range<1>{ 2 * (dim / wg_size) } };
+    sycl::buffer<uint, 1> b_partial_flags{ sycl::range<1>{ dim / wg_size } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+    sycl::buffer<uint, 1> b_state{ state, sycl::range<1>{ 2 } };
+
+    initialise_eigen_vector(q, b_eigen_vec, dim, {});
+
+    tp start = std::chrono::steady_clock::now();
+
+    // convergence decision is taken on device, so host doesn't need
+    // to look at it after every round; it enqueues `check_interval`
+    // rounds in one go & only then blocks on convergence state
+    //
+    // once converged, remaining rounds of the batch see it in device
+    // memory and return early, so they cost a kernel launch each,
+    // while iteration count & eigen value are only recorded by rounds
+    // which ran before convergence -- keeping them exact
+    const uint k = check_interval > 0 ? check_interval : 1;
+    const solver_options_t<T> opts{};
+
+    for (uint i = 0; i < MAX_ITR; i += k) {
+      const uint rounds = std::min(k, MAX_ITR - i);
+
+      for (uint j = 0; j < rounds; j++) {
+        sum_across_rows<T, SG>(
+          q, b_mat, b_sum_vec, b_state, dim, wg_size, {});
+        reduce_row_sums<T, SG>(q,
+                               b_sum_vec,
+                               b_partials,
+                               b_partial_flags,
+                               b_extrema,
+                               b_ret,
+                               dim,
+                               wg_size,
+                               opts,
+                               {});
+        compute_eigen_vector<T, SG>(
+          q, b_sum_vec, b_extrema, b_eigen_vec, b_state, dim, wg_size, {});
+        record_iteration(q, b_sum_vec, b_ret, b_state, b_eigen_val, {});
+        compute_next_matrix<T, SG>(
+          q, b_mat, b_sum_vec, b_state, dim, wg_size, {});
+      }
+
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_state{
+          b_state
+        };
+        if (h_state[0] == 1) {
+          break;
+        }
+      }
+    }
+
+    {
+      sycl::host_accessor<uint, 1, sycl::access_mode::read> h_state{ b_state };
+      *iter_count = h_state[1];
+    }
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.wait();
+  }
+
+  std::free(mat_);
+  std::free(sum_vec);
+  std::free(extrema);
+  std::free(ret);
+  std::free(state);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+speculative_similarity_transform(sycl::queue& q,
+                                 const T* mat,
+                                 T* const eigen_val,
+                                 T* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 const uint check_interval,
+                                 uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return speculative_similarity_transform_impl<T, decltype(sg)::value>(
+      q, mat, eigen_val, eigen_vec, dim, wg_size, check_interval, iter_count);
+  });
+}
+
+template<typename T, uint SG>
+static int64_t
+accelerated_similarity_transform_impl(sycl::queue& q,
+                                      const T* mat,
+                                      T* const eigen_val,
+                                      T* const eigen_vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      const uint extrapolation_interval,
+                                      uint* const iter_count)
+{
+  T* sum_vec = (T*)malloc(sizeof(T) * dim);
+  // [0] = max, [1] = min of row sums
+  T* extrema = (T*)malloc(sizeof(T) * 2);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  int64_t ts = 0;
+
+  {
+    buffer_2d_t<T> b_mat{ mat, sycl::range<2>{ dim, dim } };
+    buffer_1d_t<T> b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d_t<T> b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
+    buffer_1d_t<T> b_extrema{ extrema, sycl::range<1>{ 2 } };
+    buffer_1d_t<T> b_partials{ sycl::range<1>{ 2 * (dim / wg_size) } };
+    sycl::buffer<uint, 1> b_partial_flags{ sycl::range<1>{ dim / wg_size } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    // scaling vectors of last three rounds, in round robin order
+    buffer_1d_t<T> b_hist[3] = { buffer_1d_t<T>{ sycl::range<1>{ dim } },
+                                 buffer_1d_t<T>{ sycl::range<1>{ dim } },
+                                 buffer_1d_t<T>{ sycl::range<1>{ dim } } };
+
+    initialise_eigen_vector(q, b_eigen_vec, dim, {});
+
+    tp start = std::chrono::steady_clock::now();
+
+    // same rounds as `implicit_similarity_transform`, but every
+    // `extrapolation_interval` rounds, scaling vector is replaced by
+    // Aitken extrapolation of last three of them; history is refilled
+    // by rounds following extrapolation, so interval must be >= 3
+    const uint k = std::max(extrapolation_interval, 3u);
+    const solver_options_t<T> opts{};
+
+    uint i = 0;
+    for (; i < MAX_ITR; i++) {
+      sum_across_scaled_rows<T, T, SG>(
+        q, b_mat, b_eigen_vec, b_sum_vec, dim, wg_size, {});
+      reduce_row_sums<T, SG>(q,
+                             b_sum_vec,
+                             b_partials,
+                             b_partial_flags,
+                             b_extrema,
+                             b_ret,
+                             dim,
+                             wg_size,
+                             opts,
+                             {});
+      compute_eigen_vector<T, SG>(
+        q, b_sum_vec, b_extrema, b_eigen_vec, dim, wg_size, {});
+
+      q.submit([&](sycl::handler& h) {
+        global_1d_reader_t<T> acc_eigen_vec{ b_eigen_vec, h };
+        global_1d_writer_t<T> acc_hist{ b_hist[i % 3], h, sycl::no_init };
+
+        h.copy(acc_eigen_vec, acc_hist);
+      });
+
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+
+      if (i >= 2 && (i + 1) % k == 0) {
+        extrapolate_eigen_vector<T, SG>(q,
+                                        b_hist[(i + 1) % 3],
+                                        b_hist[(i + 2) % 3],
+                                        b_hist[i % 3],
+                                        b_eigen_vec,
+                                        dim,
+                                        wg_size,
+                                        {});
+      }
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
+      global_1d_writer_t<T> acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    q.wait();
+  }
+
+  std::free(sum_vec);
+  std::free(extrema);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+accelerated_similarity_transform(sycl::queue& q,
+                                 const T* mat,
+                                 T* const eigen_val,
+                                 T* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 const uint extrapolation_interval,
+                                 uint* const iter_count)
+{
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return accelerated_similarity_transform_impl<T, decltype(sg)::value>(
+      q,
+      mat,
+      eigen_val,
+      eigen_vec,
+      dim,
+      wg_size,
+      extrapolation_interval,
+      iter_count);
+  });
+}
+
+template<typename T, uint SG>
+sycl::event
+sum_across_rows(sycl::queue& q,
+                buffer_2d_t<T> mat,
+                buffer_1d_t<T> vec,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts)
+{
+  q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_vec{ vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_vec, T(0));
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_t<T> acc_mat{ mat, h };
+    global_1d_reader_writer_t<T> acc_vec{ vec, h };
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelSumAcrossAllRows<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        // let work group leader reset local memory
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        // make sure everyone in work group has arrived here
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        // compute sum of all subgroup elements, using reduction functionality
+        T loc_sum =
+          sycl::reduce_over_group(sg, acc_mat[r][c], sycl::plus<T>());
+
+        // let subgroup leader atomically add subgroup-local-sum to local
+        // memory
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_add(loc_sum);
+        }
+
+        // wait for all in work group to reach here
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        // only leader of work group atomically adds workgroup-local-sum
+        // to destination memory location in global memory
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(acc_vec[r]);
+          ref.fetch_add(lds[0]);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+sum_across_rows(sycl::queue& q,
+                buffer_2d_t<T> mat,
+                buffer_1d_t<T> vec,
+                sycl::buffer<uint, 1> state,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts)
+{
+  q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_vec{ vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_vec, T(0));
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_t<T> acc_mat{ mat, h };
+    global_1d_reader_writer_t<T> acc_vec{ vec, h };
+    global_flag_reader acc_state{ state, h, sycl::range<1>{ 1 } };
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelGuardedSumAcrossAllRows<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        // already converged, nothing to do; it's same for all
+        // work items, so no one is left waiting at barrier
+        if (acc_state[0] == 1) {
+          return;
+        }
+
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        T loc_sum =
+          sycl::reduce_over_group(sg, acc_mat[r][c], sycl::plus<T>());
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_add(loc_sum);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(acc_vec[r]);
+          ref.fetch_add(lds[0]);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename S, typename T, uint SG>
+sycl::event
+sum_across_scaled_rows(sycl::queue& q,
+                       sycl::buffer<S, 2> mat,
+                       buffer_1d_t<T> scale_vec,
+                       buffer_1d_t<T> vec,
+                       const uint dim,
+                       const uint wg_size,
+                       std::vector<sycl::event> evts)
+{
+  q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_vec{ vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_vec, T(0));
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_t<S> acc_mat{ mat, h };
+    global_1d_reader_t<T> acc_scale_vec{ scale_vec, h };
+    global_1d_reader_writer_t<T> acc_vec{ vec, h };
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelSumAcrossAllScaledRows<S, T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        // element (r, c) of D^-1 . A . D, computed on the fly
+        // while column scaling is applied here, row scaling
+        // is applied only once per work group, below
+        //
+        // matrix may be stored in lower precision than `T`, it's
+        // widened as soon as it's loaded
+        const T elm = static_cast<T>(acc_mat[r][c]);
+        T loc_sum =
+          sycl::reduce_over_group(sg, elm * acc_scale_vec[c], sycl::plus<T>());
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_add(loc_sum);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(acc_vec[r]);
+          ref.fetch_add(lds[0] / acc_scale_vec[r]);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+find_max(sycl::queue& q,
+         buffer_1d_t<T> vec,
+         buffer_1d_t<T> max,
+         const uint dim,
+         const uint wg_size,
+         std::vector<sycl::event> evts)
+{
+  q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_max{ max, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_max, T(0));
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_1d_reader_writer_t<T> acc_max{ max, h };
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelMaxInVector<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<1> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        // get work group leader to reset local memory allocated
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        // wait for all in work group to reach here
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t r = it.get_global_id(0);
+
+        // use reduction function to reduce to maximum value held by all
+        // work-items present in current subgroup
+        T loc_max =
+          sycl::reduce_over_group(sg, acc_vec[r], sycl::maximum<T>());
+
+        // subgroup leader atomically updates local memory
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_max(loc_max);
+        }
+
+        // wait for all in work group to reach here
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        // only work group leader writes maximum value computed in this work
+        // group to designated location in global memory
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(acc_max[0]);
+          ref.fetch_max(lds[0]);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+compute_eigen_vector(sycl::queue& q,
+                     buffer_1d_t<T> vec,
+                     buffer_1d_t<T> max,
+                     buffer_1d_t<T> eigen_vec,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_writer_t<T> acc_eigen_vec{ eigen_vec, h };
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_1d_reader_t<T> acc_max{ max, h };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelComputeEigenVector<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::ext::oneapi::sub_group sg = it.get_sub_group();
+        const size_t r = it.get_global_id(0);
+
+        T max_val = T(0);
+        if (sg.leader()) {
+          max_val = acc_max[0];
+        }
+        sg.barrier();
+
+        max_val = sycl::group_broadcast(sg, max_val);
+        acc_eigen_vec[r] *= (acc_vec[r] / max_val);
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+compute_eigen_vector(sycl::queue& q,
+                     buffer_1d_t<T> vec,
+                     buffer_1d_t<T> max,
+                     buffer_1d_t<T> eigen_vec,
+                     sycl::buffer<uint, 1> state,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_writer_t<T> acc_eigen_vec{ eigen_vec, h };
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_1d_reader_t<T> acc_max{ max, h };
+    global_flag_reader acc_state{ state, h, sycl::range<1>{ 1 } };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelGuardedComputeEigenVector<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        if (acc_state[0] == 1) {
+          return;
+        }
+
+        const size_t r = it.get_global_id(0);
+        acc_eigen_vec[r] *= (acc_vec[r] / acc_max[0]);
+      });
+  });
+
+  return evt;
+}
+
+template<typename T>
+sycl::event
+initialise_eigen_vector(sycl::queue& q,
+                        buffer_1d_t<T> vec,
+                        const uint dim,
+                        std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_vec{ vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_vec, T(1));
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+compute_next_matrix(sycl::queue& q,
+                    buffer_2d_t<T> mat,
+                    buffer_1d_t<T> vec,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_writer_t<T> acc_mat{ mat, h };
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    local_1d_reader_writer_t<T> acc_loc_row_ds{ sycl::range<1>{ 1 }, h };
+    local_1d_reader_writer_t<T> acc_loc_col_ds{ sycl::range<1>{ wg_size }, h };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelSimilarityTransform<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        const size_t ll_id = it.get_local_linear_id();
+        const size_t gl_id = it.get_global_linear_id();
+
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          acc_loc_row_ds[0] = acc_vec[r];
+        }
+        acc_loc_col_ds[ll_id] = acc_vec[gl_id % dim];
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        acc_mat[r][c] *= (T(1) / sycl::group_broadcast(sg, acc_loc_row_ds[0])) *
+                         acc_loc_col_ds[ll_id];
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+compute_next_matrix(sycl::queue& q,
+                    buffer_2d_t<T> mat,
+                    buffer_1d_t<T> vec,
+                    sycl::buffer<uint, 1> state,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_writer_t<T> acc_mat{ mat, h };
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_flag_reader acc_state{ state, h, sycl::range<1>{ 1 } };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelGuardedSimilarityTransform<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        if (acc_state[0] == 1) {
+          return;
+        }
+
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        acc_mat[r][c] *= acc_vec[c] / acc_vec[r];
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+compute_next_matrix_and_sum_rows(sycl::queue& q,
+                                 buffer_2d_t<T> mat,
+                                 buffer_1d_t<T> vec,
+                                 buffer_1d_t<T> next_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts)
+{
+  q.submit([&](sycl::handler& h) {
+    global_1d_writer_t<T> acc_next_vec{ next_vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_next_vec, T(0));
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_2d_reader_writer_t<T> acc_mat{ mat, h };
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_1d_reader_writer_t<T> acc_next_vec{ next_vec, h };
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelFusedSimilarityTransform<T, SG>>(
+      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
+                         sycl::range<2>{ 1, wg_size } },
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<2> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = T(0);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t r = it.get_global_id(0);
+        const size_t c = it.get_global_id(1);
+
+        // D^-1 . A . D, where D = diag(row sums of current matrix),
+        // written back while it's still in register, so that it can
+        // be reduced into row sum of next matrix without reading it again
+        const T elm = acc_mat[r][c] * (acc_vec[c] / acc_vec[r]);
+        acc_mat[r][c] = elm;
+
+        // from here it's same as `sum_across_rows`, only difference
+        // being input is coming from register, instead of global memory
+        T loc_sum = sycl::reduce_over_group(sg, elm, sycl::plus<T>());
+
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref(lds[0]);
+          ref.fetch_add(loc_sum);
+        }
+
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            T,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref(acc_next_vec[r]);
+          ref.fetch_add(lds[0]);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+stop(sycl::queue& q,
+     buffer_1d_t<T> vec,
+     sycl::buffer<uint, 1> ret,
+     const uint dim,
+     const uint wg_size,
+     std::vector<sycl::event> evts)
+{
+  using local_flag_reader_writer =
+    sycl::accessor<uint,
+                   1,
+                   sycl::access::mode::read_write,
+                   sycl::access::target::local>;
+
+  q.submit([&](sycl::handler& h) {
+    global_flag_reader_writer acc_ret{ ret, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(acc_ret, 1U);
+  });
+
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_flag_reader_writer acc_ret{ ret, h };
+    local_flag_reader_writer lds{ sycl::range<1>{ 1 }, h };
+
+    h.parallel_for<kernelStopCriteria<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<1> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
+
+        // first let work group leader set local memory
+        // to initial required state
+        if (sycl::ext::oneapi::leader(grp)) {
+          lds[0] = 1U;
+        }
+
+        // wait for all work items in work group to reach here
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        const size_t g_id = it.get_global_id(0);
+
+        // read value at index `i`, if work item's index is `i`
+        // i.e. just read own value
+        T self = acc_vec[g_id];
+        // use subgroup shuffling to obtain value
+        // at index `i + 1`
+        //
+        // this is tricky !
+        //
+        // assume {0, 1, 2, 3} are values kept in 4 work items,
+        // a leftwards shuffling, results into {1, 2, 3, 0}
+        // reception sequence, for work items {0, 1, 2, 3}
+        //
+        // but this is only for subgroups, we've to think about
+        // work groups
+        //
+        // say in our work group we've {0, 1, 2, 3, 4, 5, 6, 7}
+        // and we're explicitly using subgroup size of 4
+        // then after below shuffling work group level reception
+        // sequence must look like {1, 2, 3, 0, 5, 6, 7, 4}
+        //
+        // I don't want that, I want to have it received this way
+        // {1, 2, 3, 4, 5, 6, 7, 0}
+        //
+        // as next is not going to be what it's supposed to be
+        // at subgroup boundary, thus I keep below conditional block
+        // which exactly solves that problem by performing
+        // an expensive global memory read
+        //
+        // I want to reduce global memory read/ write as much as possible
+        // but this is it as of now !
+        //
+        // boundary is at lane `SG - 1`, except for work groups not being
+        // multiple of `SG`, where last subgroup is partial, so I'm
+        // comparing against actual subgroup size
+        T next = sg.shuffle_down(self, 1);
+
+        if (sg.get_local_id()[0] == (sg.get_local_range()[0] - 1)) {
+          next = acc_vec[(g_id + 1) % dim];
+        }
+
+        T diff = sycl::abs(self - next);
+        // check whether all good in subgroup level
+        bool res = sycl::all_of_group(sg, diff < EPS_T<T>);
+
+        // only let subgroup leader update status and put it
+        // in local memory
+        // use atomic op, because I don't know yet whether
+        // there's only one subgroup in work group or not
+        //
+        // anyway local memory is shared among work group participants
+        // so all subgroups have access to it
+        //
+        // if not handled carefully might result into data race
+        if (sycl::ext::oneapi::leader(sg)) {
+          sycl::ext::oneapi::atomic_ref<
+            uint,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::work_group,
+            sycl::access::address_space::local_space>
+            ref{ lds[0] };
+          ref.fetch_min(res ? 1 : 0);
+        }
+
+        // wait for all work items in work group to reach this point
+        sycl::group_barrier(grp, sycl::memory_scope::work_group);
+
+        // finally only work group leader writes work group result
+        // back to global memory, from local memory
+        if (sycl::ext::oneapi::leader(grp)) {
+          sycl::ext::oneapi::atomic_ref<
+            uint,
+            sycl::ext::oneapi::memory_order::relaxed,
+            sycl::ext::oneapi::memory_scope::device,
+            sycl::access::address_space::global_space>
+            ref{ acc_ret[0] };
+          ref.fetch_min(lds[0] ? 1 : 0);
+        }
+      });
+  });
+
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+reduce_row_sums(sycl::queue& q,
+                buffer_1d_t<T> vec,
+                buffer_1d_t<T> partials,
+                sycl::buffer<uint, 1> partial_flags,
+                buffer_1d_t<T> extrema,
+                sycl::buffer<uint, 1> ret,
+                const uint dim,
+                const uint wg_size,
+                const solver_options_t<T> opts,
+                std::vector<sycl::event> evts)
+{
+  const uint wg_count = dim / wg_size;
+  const T abs_tol = opts.abs_tol;
+  const T rel_tol = opts.rel_tol;
+  const bool gap_rule = opts.rule == stop_rule_t::relative_gap;
+
+  // first stage: each work group reduces its own slice of vector & writes
+  // result to its own slot, so there's no contention on single global
+  // memory cell, which is why nothing needs to be reset here either
+  q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_vec{ vec, h };
+    global_1d_writer_t<T> acc_partials{ partials, h, sycl::no_init };
+    sycl::accessor<uint,
+                   1,
+                   sycl::access::mode::write,
+                   sycl::access::target::global_buffer>
+      acc_partial_flags{ partial_flags, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelReduceRowSums<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<1> grp = it.get_group();
+        sycl::sub_group sg = it.get_sub_group();
 
-  memcpy(mat_, mat, sizeof(float) * dim * dim);
-  int64_t ts = 0;
+        const size_t g_id = it.get_global_id(0);
 
-  // just to automatically destroy buffers
-  // putting in different scope, so that following
-  // std::free doesn't segfault !
-  {
-    buffer_2d b_mat{ mat_, sycl::range<2>{ dim, dim } };
-    buffer_1d b_eigen_vec{ eigen_vec, sycl::range<1>{ dim } };
-    buffer_1d b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+        // same neighbour comparison as `stop`, including read from
+        // global memory at sub-group boundary
+        const T self = acc_vec[g_id];
+        T next = sg.shuffle_down(self, 1);
 
-    buffer_1d b_sum_vec{ sum_vec, sycl::range<1>{ dim } };
-    buffer_1d b_max_elm{ max_elm, sycl::range<1>{ 1 } };
-    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+        if (sg.get_local_id()[0] == (sg.get_local_range()[0] - 1)) {
+          next = acc_vec[(g_id + 1) % dim];
+        }
 
-    initialise_eigen_vector(q, b_eigen_vec, dim, {});
+        // with default options, it's exactly what `stop` checks
+        const bool res =
+          sycl::abs(self - next) < abs_tol + rel_tol * sycl::abs(self);
 
-    tp start = std::chrono::steady_clock::now();
+        // work group reductions are done by sub-groups first, then across
+        // sub-groups of work group, in local memory
+        const T max = sycl::reduce_over_group(grp, self, sycl::maximum<T>());
+        const T min = sycl::reduce_over_group(grp, self, sycl::minimum<T>());
+        const bool all = sycl::all_of_group(grp, res);
 
-    uint i = 0;
-    for (; i < MAX_ITR; i++) {
-      sum_across_rows(q, b_mat, b_sum_vec, dim, wg_size, {});
-      find_max(q, b_sum_vec, b_max_elm, dim, wg_size, {});
-      compute_eigen_vector(
-        q, b_sum_vec, b_max_elm, b_eigen_vec, dim, wg_size, {});
-      stop(q, b_sum_vec, b_ret, dim, wg_size, {});
-      {
-        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
-        if (h_ret[0] == 1) {
-          break;
+        if (sycl::ext::oneapi::leader(grp)) {
+          const size_t g = it.get_group_linear_id();
+
+          acc_partials[g] = max;
+          acc_partials[wg_count + g] = min;
+          acc_partial_flags[g] = all ? 1U : 0U;
         }
-      }
+      });
+  });
 
-      compute_next_matrix(q, b_mat, b_sum_vec, dim, wg_size, {});
-    }
-    *iter_count = i;
+  // second stage: single work group reduces per work group results
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_partials{ partials, h };
+    global_flag_reader acc_partial_flags{ partial_flags, h };
+    global_1d_writer_t<T> acc_extrema{ extrema, h, sycl::no_init };
+    global_flag_reader_writer acc_ret{ ret, h, sycl::no_init };
 
-    tp end = std::chrono::steady_clock::now();
-    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
-           .count();
+    h.parallel_for<kernelReduceRowSumsFinal<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ wg_size },
+                         sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        sycl::group<1> grp = it.get_group();
 
-    q.submit([&](sycl::handler& h) {
-      global_1d_reader acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
-      global_1d_writer acc_eigen_val{ b_eigen_val, h };
+        T max = std::numeric_limits<T>::lowest();
+        T min = std::numeric_limits<T>::max();
+        bool all = true;
 
-      h.copy(acc_sum_vec, acc_eigen_val);
-    });
-    q.wait();
-  }
+        for (size_t g = it.get_local_id(0); g < wg_count; g += wg_size) {
+          max = sycl::max(max, acc_partials[g]);
+          min = sycl::min(min, acc_partials[wg_count + g]);
+          all = all && acc_partial_flags[g] == 1U;
+        }
 
-  std::free(mat_);
-  std::free(sum_vec);
-  std::free(max_elm);
-  std::free(ret);
+        max = sycl::reduce_over_group(grp, max, sycl::maximum<T>());
+        min = sycl::reduce_over_group(grp, min, sycl::minimum<T>());
+        all = sycl::all_of_group(grp, all);
 
-  return ts;
+        // eigen value lies in [min, max], so relative gap bounds its
+        // relative error, irrespective of scale of matrix
+        if (gap_rule) {
+          all = (max - min) <= abs_tol + rel_tol * max;
+        }
+
+        if (sycl::ext::oneapi::leader(grp)) {
+          acc_extrema[0] = max;
+          acc_extrema[1] = min;
+          acc_ret[0] = all ? 1U : 0U;
+        }
+      });
+  });
+
+  return evt;
 }
 
+template<typename T>
 sycl::event
-sum_across_rows(sycl::queue& q,
-                buffer_2d mat,
-                buffer_1d vec,
-                const uint dim,
-                const uint wg_size,
-                std::vector<sycl::event> evts)
+record_iteration(sycl::queue& q,
+                 buffer_1d_t<T> vec,
+                 sycl::buffer<uint, 1> ret,
+                 sycl::buffer<uint, 1> state,
+                 buffer_1d_t<T> eigen_val,
+                 std::vector<sycl::event> evts)
 {
-  q.submit([&](sycl::handler& h) {
-    global_1d_writer acc_vec{ vec, h, sycl::no_init };
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_1d_reader_t<T> acc_vec{ vec, h, sycl::range<1>{ 1 } };
+    global_flag_reader acc_ret{ ret, h };
+    global_flag_reader_writer acc_state{ state, h };
+    global_1d_writer_t<T> acc_eigen_val{ eigen_val, h };
 
     if (!evts.empty()) {
       h.depends_on(evts);
     }
 
-    h.fill(acc_vec, 0.f);
+    h.single_task<kernelRecordIteration<T>>([=]() {
+      // rounds enqueued after convergence must not touch
+      // recorded result
+      if (acc_state[0] == 1) {
+        return;
+      }
+
+      acc_eigen_val[0] = acc_vec[0];
+      if (acc_ret[0] == 1) {
+        acc_state[0] = 1;
+      } else {
+        acc_state[1] += 1;
+      }
+    });
   });
 
+  return evt;
+}
+
+template<typename T, uint SG>
+sycl::event
+extrapolate_eigen_vector(sycl::queue& q,
+                         buffer_1d_t<T> vec_0,
+                         buffer_1d_t<T> vec_1,
+                         buffer_1d_t<T> vec_2,
+                         buffer_1d_t<T> eigen_vec,
+                         const uint dim,
+                         const uint wg_size,
+                         std::vector<sycl::event> evts)
+{
   auto evt = q.submit([&](sycl::handler& h) {
-    global_2d_reader acc_mat{ mat, h };
-    global_1d_reader_writer acc_vec{ vec, h };
-    local_1d_reader_writer lds{ sycl::range<1>{ 1 }, h };
+    global_1d_reader_t<T> acc_vec_0{ vec_0, h };
+    global_1d_reader_t<T> acc_vec_1{ vec_1, h };
+    global_1d_reader_t<T> acc_vec_2{ vec_2, h };
+    global_1d_writer_t<T> acc_eigen_vec{ eigen_vec, h };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.parallel_for<kernelExtrapolateEigenVector<T, SG>>(
+      sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
+        const size_t r = it.get_global_id(0);
+
+        const T x_0 = acc_vec_0[r];
+        const T x_1 = acc_vec_1[r];
+        const T x_2 = acc_vec_2[r];
+
+        // Aitken's delta-squared process, applied element wise
+        const T d_1 = x_2 - x_1;
+        const T d_2 = d_1 - (x_1 - x_0);
+        const T x = x_2 - (d_1 * d_1) / d_2;
+
+        // falling back to latest iterate, when sequence isn't ( yet )
+        // converging geometrically; denominator vanishes, element turns
+        // non-positive ( scaling vector must stay positive ) or
+        // extrapolation jumps further than element itself
+        const bool ok = sycl::fabs(d_2) > EPS_T<T> * x_2 && x > T(0) &&
+                        sycl::fabs(x - x_2) < x_2 && sycl::isfinite(x);
+        acc_eigen_vec[r] = ok ? x : x_2;
+      });
+  });
+
+  return evt;
+}
+
+// Following kernels work on USM allocations, instead of buffers, and they're
+// same as their buffer based counterparts ( above ), except that as there's
+// no accessor, dependencies must be explicitly passed in `evts`
+
+template<typename T, uint SG>
+sycl::event
+sum_across_scaled_rows(sycl::queue& q,
+                       const T* mat,
+                       const T* scale_vec,
+                       T* const vec,
+                       const uint dim,
+                       const uint wg_size,
+                       std::vector<sycl::event> evts)
+{
+  auto evt_0 = q.submit([&](sycl::handler& h) {
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    h.fill(vec, T(0), dim);
+  });
+
+  auto evt_1 = q.submit([&](sycl::handler& h) {
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
 
-    h.parallel_for<class kernelSumAcrossAllRows>(
+    h.depends_on(evt_0);
+    h.parallel_for<kernelSumAcrossAllScaledRowsUSM<T, SG>>(
       sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
                          sycl::range<2>{ 1, wg_size } },
-      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(32)]] {
+      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(SG)]] {
         sycl::group<2> grp = it.get_group();
         sycl::sub_group sg = it.get_sub_group();
 
-        // let work group leader reset local memory
         if (sycl::ext::oneapi::leader(grp)) {
-          lds[0] = 0.f;
+          lds[0] = T(0);
         }
 
-        // make sure everyone in work group has arrived here
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
         const size_t r = it.get_global_id(0);
         const size_t c = it.get_global_id(1);
 
-        // compute sum of all subgroup elements, using reduction functionality
-        float loc_sum =
-          sycl::reduce_over_group(sg, acc_mat[r][c], sycl::plus<float>());
+        T loc_sum = sycl::reduce_over_group(
+          sg, mat[r * dim + c] * scale_vec[c], sycl::plus<T>());
 
-        // let subgroup leader atomically add subgroup-local-sum to local
-        // memory
         if (sycl::ext::oneapi::leader(sg)) {
           sycl::ext::oneapi::atomic_ref<
-            float,
+            T,
             sycl::ext::oneapi::memory_order::relaxed,
             sycl::ext::oneapi::memory_scope::work_group,
             sycl::access::address_space::local_space>
@@ -131,74 +1848,64 @@ sum_across_rows(sycl::queue& q,
           ref.fetch_add(loc_sum);
         }
 
-        // wait for all in work group to reach here
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
-        // only leader of work group atomically adds workgroup-local-sum
-        // to destination memory location in global memory
         if (sycl::ext::oneapi::leader(grp)) {
           sycl::ext::oneapi::atomic_ref<
-            float,
+            T,
             sycl::ext::oneapi::memory_order::relaxed,
             sycl::ext::oneapi::memory_scope::device,
             sycl::access::address_space::global_space>
-            ref(acc_vec[r]);
-          ref.fetch_add(lds[0]);
+            ref(vec[r]);
+          ref.fetch_add(lds[0] / scale_vec[r]);
         }
       });
   });
 
-  return evt;
+  return evt_1;
 }
 
+template<typename T, uint SG>
 sycl::event
 find_max(sycl::queue& q,
-         buffer_1d vec,
-         buffer_1d max,
+         const T* vec,
+         T* const max,
          const uint dim,
          const uint wg_size,
          std::vector<sycl::event> evts)
 {
-  q.submit([&](sycl::handler& h) {
-    global_1d_writer acc_max{ max, h, sycl::no_init };
-
+  auto evt_0 = q.submit([&](sycl::handler& h) {
     if (!evts.empty()) {
       h.depends_on(evts);
     }
 
-    h.fill(acc_max, 0.f);
+    h.fill(max, T(0), 1);
   });
 
-  auto evt = q.submit([&](sycl::handler& h) {
-    global_1d_reader acc_vec{ vec, h };
-    global_1d_reader_writer acc_max{ max, h };
-    local_1d_reader_writer lds{ sycl::range<1>{ 1 }, h };
+  auto evt_1 = q.submit([&](sycl::handler& h) {
+    local_1d_reader_writer_t<T> lds{ sycl::range<1>{ 1 }, h };
 
-    h.parallel_for<class kernelMaxInVector>(
+    h.depends_on(evt_0);
+    h.parallel_for<kernelMaxInVectorUSM<T, SG>>(
       sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
-      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(32)]] {
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
         sycl::group<1> grp = it.get_group();
         sycl::sub_group sg = it.get_sub_group();
 
-        // get work group leader to reset local memory allocated
         if (sycl::ext::oneapi::leader(grp)) {
-          lds[0] = 0.f;
+          lds[0] = T(0);
         }
 
-        // wait for all in work group to reach here
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
         const size_t r = it.get_global_id(0);
 
-        // use reduction function to reduce to maximum value held by all
-        // work-items present in current subgroup
-        float loc_max =
-          sycl::reduce_over_group(sg, acc_vec[r], sycl::maximum<float>());
+        T loc_max =
+          sycl::reduce_over_group(sg, vec[r], sycl::maximum<T>());
 
-        // subgroup leader atomically updates local memory
         if (sycl::ext::oneapi::leader(sg)) {
           sycl::ext::oneapi::atomic_ref<
-            float,
+            T,
             sycl::ext::oneapi::memory_order::relaxed,
             sycl::ext::oneapi::memory_scope::work_group,
             sycl::access::address_space::local_space>
@@ -206,229 +1913,129 @@ find_max(sycl::queue& q,
           ref.fetch_max(loc_max);
         }
 
-        // wait for all in work group to reach here
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
-        // only work group leader writes maximum value computed in this work
-        // group to designated location in global memory
         if (sycl::ext::oneapi::leader(grp)) {
           sycl::ext::oneapi::atomic_ref<
-            float,
+            T,
             sycl::ext::oneapi::memory_order::relaxed,
             sycl::ext::oneapi::memory_scope::device,
             sycl::access::address_space::global_space>
-            ref(acc_max[0]);
+            ref(max[0]);
           ref.fetch_max(lds[0]);
         }
       });
   });
 
-  return evt;
+  return evt_1;
 }
 
+template<typename T, uint SG>
 sycl::event
 compute_eigen_vector(sycl::queue& q,
-                     buffer_1d vec,
-                     buffer_1d max,
-                     buffer_1d eigen_vec,
+                     const T* vec,
+                     const T* max,
+                     T* const eigen_vec,
                      const uint dim,
                      const uint wg_size,
                      std::vector<sycl::event> evts)
 {
   auto evt = q.submit([&](sycl::handler& h) {
-    global_1d_reader_writer acc_eigen_vec{ eigen_vec, h };
-    global_1d_reader acc_vec{ vec, h };
-    global_1d_reader acc_max{ max, h };
-
     if (!evts.empty()) {
       h.depends_on(evts);
     }
 
-    h.parallel_for<class kernelComputeEigenVector>(
+    h.parallel_for<kernelComputeEigenVectorUSM<T, SG>>(
       sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
-      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(32)]] {
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
         sycl::ext::oneapi::sub_group sg = it.get_sub_group();
         const size_t r = it.get_global_id(0);
 
-        float max_val = 0.f;
+        T max_val = T(0);
         if (sg.leader()) {
-          max_val = acc_max[0];
+          max_val = max[0];
         }
         sg.barrier();
 
         max_val = sycl::group_broadcast(sg, max_val);
-        acc_eigen_vec[r] *= (acc_vec[r] / max_val);
+        eigen_vec[r] *= (vec[r] / max_val);
       });
   });
 
   return evt;
 }
 
+template<typename T>
 sycl::event
 initialise_eigen_vector(sycl::queue& q,
-                        buffer_1d vec,
+                        T* const vec,
                         const uint dim,
                         std::vector<sycl::event> evts)
 {
   auto evt = q.submit([&](sycl::handler& h) {
-    global_1d_writer acc_vec{ vec, h, sycl::no_init };
-
-    if (!evts.empty()) {
-      h.depends_on(evts);
-    }
-
-    h.fill(acc_vec, 1.f);
-  });
-
-  return evt;
-}
-
-sycl::event
-compute_next_matrix(sycl::queue& q,
-                    buffer_2d mat,
-                    buffer_1d vec,
-                    const uint dim,
-                    const uint wg_size,
-                    std::vector<sycl::event> evts)
-{
-  auto evt = q.submit([&](sycl::handler& h) {
-    global_2d_reader_writer acc_mat{ mat, h };
-    global_1d_reader acc_vec{ vec, h };
-    local_1d_reader_writer acc_loc_row_ds{ sycl::range<1>{ 1 }, h };
-    local_1d_reader_writer acc_loc_col_ds{ sycl::range<1>{ wg_size }, h };
-
     if (!evts.empty()) {
       h.depends_on(evts);
     }
 
-    h.parallel_for<class kernelSimilarityTransform>(
-      sycl::nd_range<2>{ sycl::range<2>{ dim, dim },
-                         sycl::range<2>{ 1, wg_size } },
-      [=](sycl::nd_item<2> it) [[intel::reqd_sub_group_size(32)]] {
-        const size_t r = it.get_global_id(0);
-        const size_t c = it.get_global_id(1);
-
-        const size_t ll_id = it.get_local_linear_id();
-        const size_t gl_id = it.get_global_linear_id();
-
-        sycl::group<2> grp = it.get_group();
-        sycl::sub_group sg = it.get_sub_group();
-
-        if (sycl::ext::oneapi::leader(grp)) {
-          acc_loc_row_ds[0] = acc_vec[r];
-        }
-        acc_loc_col_ds[ll_id] = acc_vec[gl_id % dim];
-
-        sycl::group_barrier(grp, sycl::memory_scope::work_group);
-
-        acc_mat[r][c] *= (1.f / sycl::group_broadcast(sg, acc_loc_row_ds[0])) *
-                         acc_loc_col_ds[ll_id];
-      });
+    h.fill(vec, T(1), dim);
   });
 
   return evt;
 }
 
+template<typename T, uint SG>
 sycl::event
 stop(sycl::queue& q,
-     buffer_1d vec,
-     sycl::buffer<uint, 1> ret,
+     const T* vec,
+     uint* const ret,
      const uint dim,
      const uint wg_size,
      std::vector<sycl::event> evts)
 {
-  using global_flag_reader_writer =
-    sycl::accessor<uint,
-                   1,
-                   sycl::access::mode::read_write,
-                   sycl::access::target::global_buffer>;
   using local_flag_reader_writer =
     sycl::accessor<uint,
                    1,
                    sycl::access::mode::read_write,
                    sycl::access::target::local>;
 
-  q.submit([&](sycl::handler& h) {
-    global_flag_reader_writer acc_ret{ ret, h, sycl::no_init };
-
+  auto evt_0 = q.submit([&](sycl::handler& h) {
     if (!evts.empty()) {
       h.depends_on(evts);
     }
 
-    h.fill(acc_ret, 1U);
+    h.fill(ret, 1U, 1);
   });
 
-  auto evt = q.submit([&](sycl::handler& h) {
-    global_1d_reader acc_vec{ vec, h };
-    global_flag_reader_writer acc_ret{ ret, h };
+  auto evt_1 = q.submit([&](sycl::handler& h) {
     local_flag_reader_writer lds{ sycl::range<1>{ 1 }, h };
 
-    h.parallel_for<class kernelStopCriteria>(
+    h.depends_on(evt_0);
+    h.parallel_for<kernelStopCriteriaUSM<T, SG>>(
       sycl::nd_range<1>{ sycl::range<1>{ dim }, sycl::range<1>{ wg_size } },
-      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(32)]] {
+      [=](sycl::nd_item<1> it) [[intel::reqd_sub_group_size(SG)]] {
         sycl::group<1> grp = it.get_group();
         sycl::sub_group sg = it.get_sub_group();
 
-        // first let work group leader set local memory
-        // to initial required state
         if (sycl::ext::oneapi::leader(grp)) {
           lds[0] = 1U;
         }
 
-        // wait for all work items in work group to reach here
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
         const size_t g_id = it.get_global_id(0);
 
-        // read value at index `i`, if work item's index is `i`
-        // i.e. just read own value
-        float self = acc_vec[g_id];
-        // use subgroup shuffling to obtain value
-        // at index `i + 1`
-        //
-        // this is tricky !
-        //
-        // assume {0, 1, 2, 3} are values kept in 4 work items,
-        // a leftwards shuffling, results into {1, 2, 3, 0}
-        // reception sequence, for work items {0, 1, 2, 3}
-        //
-        // but this is only for subgroups, we've to think about
-        // work groups
-        //
-        // say in our work group we've {0, 1, 2, 3, 4, 5, 6, 7}
-        // and we're explicitly using subgroup size of 4
-        // then after below shuffling work group level reception
-        // sequence must look like {1, 2, 3, 0, 5, 6, 7, 4}
-        //
-        // I don't want that, I want to have it received this way
-        // {1, 2, 3, 4, 5, 6, 7, 0}
-        //
-        // as next is not going to be what it's supposed to be
-        // at subgroup boundary, thus I keep below conditional block
-        // which exactly solves that problem by performing
-        // an expensive global memory read
-        //
-        // I want to reduce global memory read/ write as much as possible
-        // but this is it as of now !
-        float next = sg.shuffle_down(self, 1);
+        // see buffer based `stop` for why last work item of subgroup
+        // reads its neighbour from global memory
+        T self = vec[g_id];
+        T next = sg.shuffle_down(self, 1);
 
         if (sg.get_local_id()[0] == (sg.get_local_range()[0] - 1)) {
-          next = acc_vec[(g_id + 1) % dim];
+          next = vec[(g_id + 1) % dim];
         }
 
-        float diff = sycl::abs(self - next);
-        // check whether all good in subgroup level
-        bool res = sycl::all_of_group(sg, diff < EPS);
+        T diff = sycl::abs(self - next);
+        bool res = sycl::all_of_group(sg, diff < EPS_T<T>);
 
-        // only let subgroup leader update status and put it
-        // in local memory
-        // use atomic op, because I don't know yet whether
-        // there's only one subgroup in work group or not
-        //
-        // anyway local memory is shared among work group participants
-        // so all subgroups have access to it
-        //
-        // if not handled carefully might result into data race
         if (sycl::ext::oneapi::leader(sg)) {
           sycl::ext::oneapi::atomic_ref<
             uint,
@@ -439,22 +2046,1188 @@ stop(sycl::queue& q,
           ref.fetch_min(res ? 1 : 0);
         }
 
-        // wait for all work items in work group to reach this point
         sycl::group_barrier(grp, sycl::memory_scope::work_group);
 
-        // finally only work group leader writes work group result
-        // back to global memory, from local memory
         if (sycl::ext::oneapi::leader(grp)) {
           sycl::ext::oneapi::atomic_ref<
             uint,
             sycl::ext::oneapi::memory_order::relaxed,
             sycl::ext::oneapi::memory_scope::device,
             sycl::access::address_space::global_space>
-            ref{ acc_ret[0] };
+            ref{ ret[0] };
           ref.fetch_min(lds[0] ? 1 : 0);
         }
       });
   });
 
-  return evt;
+  return evt_1;
 }
+
+template int64_t
+similarity_transform<float>(sycl::queue& q,
+                            const float* mat,
+                            float* const eigen_val,
+                            float* const eigen_vec,
+                            const uint dim,
+                            const uint wg_size,
+                            uint* const iter_count);
+
+template int64_t
+similarity_transform<float>(sycl::queue& q,
+                            const float* mat,
+                            float* const eigen_val,
+                            float* const eigen_vec,
+                            const float* init_vec,
+                            const uint dim,
+                            const uint wg_size,
+                            uint* const iter_count);
+
+template int64_t
+similarity_transform<float>(sycl::queue& q,
+                            const float* mat,
+                            float* const eigen_val,
+                            float* const eigen_vec,
+                            const float* init_vec,
+                            float* const bounds,
+                            const uint dim,
+                            const uint wg_size,
+                            uint* const iter_count);
+
+template int64_t
+similarity_transform<float>(sycl::queue& q,
+                            const float* mat,
+                            float* const eigen_val,
+                            float* const eigen_vec,
+                            const float* init_vec,
+                            float* const bounds,
+                            const uint dim,
+                            const uint wg_size,
+                            const solver_options_t<float>& opts,
+                            uint* const iter_count);
+
+template int64_t
+similarity_transform<double>(sycl::queue& q,
+                             const double* mat,
+                             double* const eigen_val,
+                             double* const eigen_vec,
+                             const uint dim,
+                             const uint wg_size,
+                             uint* const iter_count);
+
+template int64_t
+similarity_transform<double>(sycl::queue& q,
+                             const double* mat,
+                             double* const eigen_val,
+                             double* const eigen_vec,
+                             const double* init_vec,
+                             const uint dim,
+                             const uint wg_size,
+                             uint* const iter_count);
+
+template int64_t
+similarity_transform<double>(sycl::queue& q,
+                             const double* mat,
+                             double* const eigen_val,
+                             double* const eigen_vec,
+                             const double* init_vec,
+                             double* const bounds,
+                             const uint dim,
+                             const uint wg_size,
+                             uint* const iter_count);
+
+template int64_t
+similarity_transform<double>(sycl::queue& q,
+                             const double* mat,
+                             double* const eigen_val,
+                             double* const eigen_vec,
+                             const double* init_vec,
+                             double* const bounds,
+                             const uint dim,
+                             const uint wg_size,
+                             const solver_options_t<double>& opts,
+                             uint* const iter_count);
+
+template int64_t
+fused_similarity_transform<float>(sycl::queue& q,
+                                  const float* mat,
+                                  float* const eigen_val,
+                                  float* const eigen_vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  uint* const iter_count);
+
+template int64_t
+fused_similarity_transform<double>(sycl::queue& q,
+                                   const double* mat,
+                                   double* const eigen_val,
+                                   double* const eigen_vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<float>(sycl::queue& q,
+                                     const float* mat,
+                                     float* const eigen_val,
+                                     float* const eigen_vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<float>(sycl::queue& q,
+                                     const float* mat,
+                                     float* const eigen_val,
+                                     float* const eigen_vec,
+                                     const float* init_vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<float>(sycl::queue& q,
+                                     const float* mat,
+                                     float* const eigen_val,
+                                     float* const eigen_vec,
+                                     const float* init_vec,
+                                     float* const bounds,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<float>(sycl::queue& q,
+                                     const float* mat,
+                                     float* const eigen_val,
+                                     float* const eigen_vec,
+                                     const float* init_vec,
+                                     float* const bounds,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     const solver_options_t<float>& opts,
+                                     uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<double>(sycl::queue& q,
+                                      const double* mat,
+                                      double* const eigen_val,
+                                      double* const eigen_vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<double>(sycl::queue& q,
+                                      const double* mat,
+                                      double* const eigen_val,
+                                      double* const eigen_vec,
+                                      const double* init_vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<double>(sycl::queue& q,
+                                      const double* mat,
+                                      double* const eigen_val,
+                                      double* const eigen_vec,
+                                      const double* init_vec,
+                                      double* const bounds,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<double>(sycl::queue& q,
+                                      const double* mat,
+                                      double* const eigen_val,
+                                      double* const eigen_vec,
+                                      const double* init_vec,
+                                      double* const bounds,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      const solver_options_t<double>& opts,
+                                      uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<float>(sycl::queue& q,
+                                     buffer_2d_t<float> mat,
+                                     float* const eigen_val,
+                                     float* const eigen_vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     uint* const iter_count);
+
+template int64_t
+implicit_similarity_transform<double>(sycl::queue& q,
+                                      buffer_2d_t<double> mat,
+                                      double* const eigen_val,
+                                      double* const eigen_vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+speculative_similarity_transform<float>(sycl::queue& q,
+                                        const float* mat,
+                                        float* const eigen_val,
+                                        float* const eigen_vec,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        const uint check_interval,
+                                        uint* const iter_count);
+
+template int64_t
+speculative_similarity_transform<double>(sycl::queue& q,
+                                         const double* mat,
+                                         double* const eigen_val,
+                                         double* const eigen_vec,
+                                         const uint dim,
+                                         const uint wg_size,
+                                         const uint check_interval,
+                                         uint* const iter_count);
+
+template int64_t
+accelerated_similarity_transform<float>(sycl::queue& q,
+                                        const float* mat,
+                                        float* const eigen_val,
+                                        float* const eigen_vec,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        const uint extrapolation_interval,
+                                        uint* const iter_count);
+
+template int64_t
+accelerated_similarity_transform<double>(sycl::queue& q,
+                                         const double* mat,
+                                         double* const eigen_val,
+                                         double* const eigen_vec,
+                                         const uint dim,
+                                         const uint wg_size,
+                                         const uint extrapolation_interval,
+                                         uint* const iter_count);
+
+template sycl::event
+sum_across_rows<float, 8>(sycl::queue& q,
+                          buffer_2d_t<float> mat,
+                          buffer_1d_t<float> vec,
+                          const uint dim,
+                          const uint wg_size,
+                          std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<float, 16>(sycl::queue& q,
+                           buffer_2d_t<float> mat,
+                           buffer_1d_t<float> vec,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<float, 32>(sycl::queue& q,
+                           buffer_2d_t<float> mat,
+                           buffer_1d_t<float> vec,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 8>(sycl::queue& q,
+                           buffer_2d_t<double> mat,
+                           buffer_1d_t<double> vec,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 16>(sycl::queue& q,
+                            buffer_2d_t<double> mat,
+                            buffer_1d_t<double> vec,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 32>(sycl::queue& q,
+                            buffer_2d_t<double> mat,
+                            buffer_1d_t<double> vec,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<float, 8>(sycl::queue& q,
+                          buffer_2d_t<float> mat,
+                          buffer_1d_t<float> vec,
+                          sycl::buffer<uint, 1> state,
+                          const uint dim,
+                          const uint wg_size,
+                          std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<float, 16>(sycl::queue& q,
+                           buffer_2d_t<float> mat,
+                           buffer_1d_t<float> vec,
+                           sycl::buffer<uint, 1> state,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<float, 32>(sycl::queue& q,
+                           buffer_2d_t<float> mat,
+                           buffer_1d_t<float> vec,
+                           sycl::buffer<uint, 1> state,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 8>(sycl::queue& q,
+                           buffer_2d_t<double> mat,
+                           buffer_1d_t<double> vec,
+                           sycl::buffer<uint, 1> state,
+                           const uint dim,
+                           const uint wg_size,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 16>(sycl::queue& q,
+                            buffer_2d_t<double> mat,
+                            buffer_1d_t<double> vec,
+                            sycl::buffer<uint, 1> state,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_rows<double, 32>(sycl::queue& q,
+                            buffer_2d_t<double> mat,
+                            buffer_1d_t<double> vec,
+                            sycl::buffer<uint, 1> state,
+                            const uint dim,
+                            const uint wg_size,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, float, 8>(sycl::queue& q,
+                                        sycl::buffer<float, 2> mat,
+                                        buffer_1d_t<float> scale_vec,
+                                        buffer_1d_t<float> vec,
+                                        const uint dim,
+                                        const uint wg_size,
+                                        std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, float, 16>(sycl::queue& q,
+                                         sycl::buffer<float, 2> mat,
+                                         buffer_1d_t<float> scale_vec,
+                                         buffer_1d_t<float> vec,
+                                         const uint dim,
+                                         const uint wg_size,
+                                         std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, float, 32>(sycl::queue& q,
+                                         sycl::buffer<float, 2> mat,
+                                         buffer_1d_t<float> scale_vec,
+                                         buffer_1d_t<float> vec,
+                                         const uint dim,
+                                         const uint wg_size,
+                                         std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, double, 8>(sycl::queue& q,
+                                          sycl::buffer<double, 2> mat,
+                                          buffer_1d_t<double> scale_vec,
+                                          buffer_1d_t<double> vec,
+                                          const uint dim,
+                                          const uint wg_size,
+                                          std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, double, 16>(sycl::queue& q,
+                                           sycl::buffer<double, 2> mat,
+                                           buffer_1d_t<double> scale_vec,
+                                           buffer_1d_t<double> vec,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, double, 32>(sycl::queue& q,
+                                           sycl::buffer<double, 2> mat,
+                                           buffer_1d_t<double> scale_vec,
+                                           buffer_1d_t<double> vec,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<sycl::half, float, 8>(sycl::queue& q,
+                                             sycl::buffer<sycl::half, 2> mat,
+                                             buffer_1d_t<float> scale_vec,
+                                             buffer_1d_t<float> vec,
+                                             const uint dim,
+                                             const uint wg_size,
+                                             std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<sycl::half, float, 16>(sycl::queue& q,
+                                              sycl::buffer<sycl::half, 2> mat,
+                                              buffer_1d_t<float> scale_vec,
+                                              buffer_1d_t<float> vec,
+                                              const uint dim,
+                                              const uint wg_size,
+                                              std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<sycl::half, float, 32>(sycl::queue& q,
+                                              sycl::buffer<sycl::half, 2> mat,
+                                              buffer_1d_t<float> scale_vec,
+                                              buffer_1d_t<float> vec,
+                                              const uint dim,
+                                              const uint wg_size,
+                                              std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 8>(sycl::queue& q,
+                   buffer_1d_t<float> vec,
+                   buffer_1d_t<float> max,
+                   const uint dim,
+                   const uint wg_size,
+                   std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 16>(sycl::queue& q,
+                    buffer_1d_t<float> vec,
+                    buffer_1d_t<float> max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 32>(sycl::queue& q,
+                    buffer_1d_t<float> vec,
+                    buffer_1d_t<float> max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 8>(sycl::queue& q,
+                    buffer_1d_t<double> vec,
+                    buffer_1d_t<double> max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 16>(sycl::queue& q,
+                     buffer_1d_t<double> vec,
+                     buffer_1d_t<double> max,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 32>(sycl::queue& q,
+                     buffer_1d_t<double> vec,
+                     buffer_1d_t<double> max,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 8>(sycl::queue& q,
+                               buffer_1d_t<float> vec,
+                               buffer_1d_t<float> max,
+                               buffer_1d_t<float> eigen_vec,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 16>(sycl::queue& q,
+                                buffer_1d_t<float> vec,
+                                buffer_1d_t<float> max,
+                                buffer_1d_t<float> eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 32>(sycl::queue& q,
+                                buffer_1d_t<float> vec,
+                                buffer_1d_t<float> max,
+                                buffer_1d_t<float> eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 8>(sycl::queue& q,
+                                buffer_1d_t<double> vec,
+                                buffer_1d_t<double> max,
+                                buffer_1d_t<double> eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 16>(sycl::queue& q,
+                                 buffer_1d_t<double> vec,
+                                 buffer_1d_t<double> max,
+                                 buffer_1d_t<double> eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 32>(sycl::queue& q,
+                                 buffer_1d_t<double> vec,
+                                 buffer_1d_t<double> max,
+                                 buffer_1d_t<double> eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 8>(sycl::queue& q,
+                               buffer_1d_t<float> vec,
+                               buffer_1d_t<float> max,
+                               buffer_1d_t<float> eigen_vec,
+                               sycl::buffer<uint, 1> state,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 16>(sycl::queue& q,
+                                buffer_1d_t<float> vec,
+                                buffer_1d_t<float> max,
+                                buffer_1d_t<float> eigen_vec,
+                                sycl::buffer<uint, 1> state,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 32>(sycl::queue& q,
+                                buffer_1d_t<float> vec,
+                                buffer_1d_t<float> max,
+                                buffer_1d_t<float> eigen_vec,
+                                sycl::buffer<uint, 1> state,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 8>(sycl::queue& q,
+                                buffer_1d_t<double> vec,
+                                buffer_1d_t<double> max,
+                                buffer_1d_t<double> eigen_vec,
+                                sycl::buffer<uint, 1> state,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 16>(sycl::queue& q,
+                                 buffer_1d_t<double> vec,
+                                 buffer_1d_t<double> max,
+                                 buffer_1d_t<double> eigen_vec,
+                                 sycl::buffer<uint, 1> state,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 32>(sycl::queue& q,
+                                 buffer_1d_t<double> vec,
+                                 buffer_1d_t<double> max,
+                                 buffer_1d_t<double> eigen_vec,
+                                 sycl::buffer<uint, 1> state,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+initialise_eigen_vector<float>(sycl::queue& q,
+                               buffer_1d_t<float> vec,
+                               const uint dim,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+initialise_eigen_vector<double>(sycl::queue& q,
+                                buffer_1d_t<double> vec,
+                                const uint dim,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 8>(sycl::queue& q,
+                              buffer_2d_t<float> mat,
+                              buffer_1d_t<float> vec,
+                              const uint dim,
+                              const uint wg_size,
+                              std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 16>(sycl::queue& q,
+                               buffer_2d_t<float> mat,
+                               buffer_1d_t<float> vec,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 32>(sycl::queue& q,
+                               buffer_2d_t<float> mat,
+                               buffer_1d_t<float> vec,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 8>(sycl::queue& q,
+                               buffer_2d_t<double> mat,
+                               buffer_1d_t<double> vec,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 16>(sycl::queue& q,
+                                buffer_2d_t<double> mat,
+                                buffer_1d_t<double> vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 32>(sycl::queue& q,
+                                buffer_2d_t<double> mat,
+                                buffer_1d_t<double> vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 8>(sycl::queue& q,
+                              buffer_2d_t<float> mat,
+                              buffer_1d_t<float> vec,
+                              sycl::buffer<uint, 1> state,
+                              const uint dim,
+                              const uint wg_size,
+                              std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 16>(sycl::queue& q,
+                               buffer_2d_t<float> mat,
+                               buffer_1d_t<float> vec,
+                               sycl::buffer<uint, 1> state,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<float, 32>(sycl::queue& q,
+                               buffer_2d_t<float> mat,
+                               buffer_1d_t<float> vec,
+                               sycl::buffer<uint, 1> state,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 8>(sycl::queue& q,
+                               buffer_2d_t<double> mat,
+                               buffer_1d_t<double> vec,
+                               sycl::buffer<uint, 1> state,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 16>(sycl::queue& q,
+                                buffer_2d_t<double> mat,
+                                buffer_1d_t<double> vec,
+                                sycl::buffer<uint, 1> state,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix<double, 32>(sycl::queue& q,
+                                buffer_2d_t<double> mat,
+                                buffer_1d_t<double> vec,
+                                sycl::buffer<uint, 1> state,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<float, 8>(sycl::queue& q,
+                                           buffer_2d_t<float> mat,
+                                           buffer_1d_t<float> vec,
+                                           buffer_1d_t<float> next_vec,
+                                           const uint dim,
+                                           const uint wg_size,
+                                           std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<float, 16>(sycl::queue& q,
+                                            buffer_2d_t<float> mat,
+                                            buffer_1d_t<float> vec,
+                                            buffer_1d_t<float> next_vec,
+                                            const uint dim,
+                                            const uint wg_size,
+                                            std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<float, 32>(sycl::queue& q,
+                                            buffer_2d_t<float> mat,
+                                            buffer_1d_t<float> vec,
+                                            buffer_1d_t<float> next_vec,
+                                            const uint dim,
+                                            const uint wg_size,
+                                            std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<double, 8>(sycl::queue& q,
+                                            buffer_2d_t<double> mat,
+                                            buffer_1d_t<double> vec,
+                                            buffer_1d_t<double> next_vec,
+                                            const uint dim,
+                                            const uint wg_size,
+                                            std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<double, 16>(sycl::queue& q,
+                                             buffer_2d_t<double> mat,
+                                             buffer_1d_t<double> vec,
+                                             buffer_1d_t<double> next_vec,
+                                             const uint dim,
+                                             const uint wg_size,
+                                             std::vector<sycl::event> evts);
+
+template sycl::event
+compute_next_matrix_and_sum_rows<double, 32>(sycl::queue& q,
+                                             buffer_2d_t<double> mat,
+                                             buffer_1d_t<double> vec,
+                                             buffer_1d_t<double> next_vec,
+                                             const uint dim,
+                                             const uint wg_size,
+                                             std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 8>(sycl::queue& q,
+               buffer_1d_t<float> vec,
+               sycl::buffer<uint, 1> ret,
+               const uint dim,
+               const uint wg_size,
+               std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 16>(sycl::queue& q,
+                buffer_1d_t<float> vec,
+                sycl::buffer<uint, 1> ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 32>(sycl::queue& q,
+                buffer_1d_t<float> vec,
+                sycl::buffer<uint, 1> ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 8>(sycl::queue& q,
+                buffer_1d_t<double> vec,
+                sycl::buffer<uint, 1> ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 16>(sycl::queue& q,
+                 buffer_1d_t<double> vec,
+                 sycl::buffer<uint, 1> ret,
+                 const uint dim,
+                 const uint wg_size,
+                 std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 32>(sycl::queue& q,
+                 buffer_1d_t<double> vec,
+                 sycl::buffer<uint, 1> ret,
+                 const uint dim,
+                 const uint wg_size,
+                 std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<float, 8>(sycl::queue& q,
+                          buffer_1d_t<float> vec,
+                          buffer_1d_t<float> partials,
+                          sycl::buffer<uint, 1> partial_flags,
+                          buffer_1d_t<float> extrema,
+                          sycl::buffer<uint, 1> ret,
+                          const uint dim,
+                          const uint wg_size,
+                          const solver_options_t<float> opts,
+                          std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<float, 16>(sycl::queue& q,
+                           buffer_1d_t<float> vec,
+                           buffer_1d_t<float> partials,
+                           sycl::buffer<uint, 1> partial_flags,
+                           buffer_1d_t<float> extrema,
+                           sycl::buffer<uint, 1> ret,
+                           const uint dim,
+                           const uint wg_size,
+                           const solver_options_t<float> opts,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<float, 32>(sycl::queue& q,
+                           buffer_1d_t<float> vec,
+                           buffer_1d_t<float> partials,
+                           sycl::buffer<uint, 1> partial_flags,
+                           buffer_1d_t<float> extrema,
+                           sycl::buffer<uint, 1> ret,
+                           const uint dim,
+                           const uint wg_size,
+                           const solver_options_t<float> opts,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<double, 8>(sycl::queue& q,
+                           buffer_1d_t<double> vec,
+                           buffer_1d_t<double> partials,
+                           sycl::buffer<uint, 1> partial_flags,
+                           buffer_1d_t<double> extrema,
+                           sycl::buffer<uint, 1> ret,
+                           const uint dim,
+                           const uint wg_size,
+                           const solver_options_t<double> opts,
+                           std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<double, 16>(sycl::queue& q,
+                            buffer_1d_t<double> vec,
+                            buffer_1d_t<double> partials,
+                            sycl::buffer<uint, 1> partial_flags,
+                            buffer_1d_t<double> extrema,
+                            sycl::buffer<uint, 1> ret,
+                            const uint dim,
+                            const uint wg_size,
+                            const solver_options_t<double> opts,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+reduce_row_sums<double, 32>(sycl::queue& q,
+                            buffer_1d_t<double> vec,
+                            buffer_1d_t<double> partials,
+                            sycl::buffer<uint, 1> partial_flags,
+                            buffer_1d_t<double> extrema,
+                            sycl::buffer<uint, 1> ret,
+                            const uint dim,
+                            const uint wg_size,
+                            const solver_options_t<double> opts,
+                            std::vector<sycl::event> evts);
+
+template sycl::event
+record_iteration<float>(sycl::queue& q,
+                        buffer_1d_t<float> vec,
+                        sycl::buffer<uint, 1> ret,
+                        sycl::buffer<uint, 1> state,
+                        buffer_1d_t<float> eigen_val,
+                        std::vector<sycl::event> evts);
+
+template sycl::event
+record_iteration<double>(sycl::queue& q,
+                         buffer_1d_t<double> vec,
+                         sycl::buffer<uint, 1> ret,
+                         sycl::buffer<uint, 1> state,
+                         buffer_1d_t<double> eigen_val,
+                         std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<float, 8>(sycl::queue& q,
+                                   buffer_1d_t<float> vec_0,
+                                   buffer_1d_t<float> vec_1,
+                                   buffer_1d_t<float> vec_2,
+                                   buffer_1d_t<float> eigen_vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<float, 16>(sycl::queue& q,
+                                    buffer_1d_t<float> vec_0,
+                                    buffer_1d_t<float> vec_1,
+                                    buffer_1d_t<float> vec_2,
+                                    buffer_1d_t<float> eigen_vec,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<float, 32>(sycl::queue& q,
+                                    buffer_1d_t<float> vec_0,
+                                    buffer_1d_t<float> vec_1,
+                                    buffer_1d_t<float> vec_2,
+                                    buffer_1d_t<float> eigen_vec,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<double, 8>(sycl::queue& q,
+                                    buffer_1d_t<double> vec_0,
+                                    buffer_1d_t<double> vec_1,
+                                    buffer_1d_t<double> vec_2,
+                                    buffer_1d_t<double> eigen_vec,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<double, 16>(sycl::queue& q,
+                                     buffer_1d_t<double> vec_0,
+                                     buffer_1d_t<double> vec_1,
+                                     buffer_1d_t<double> vec_2,
+                                     buffer_1d_t<double> eigen_vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     std::vector<sycl::event> evts);
+
+template sycl::event
+extrapolate_eigen_vector<double, 32>(sycl::queue& q,
+                                     buffer_1d_t<double> vec_0,
+                                     buffer_1d_t<double> vec_1,
+                                     buffer_1d_t<double> vec_2,
+                                     buffer_1d_t<double> eigen_vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, 8>(sycl::queue& q,
+                                 const float* mat,
+                                 const float* scale_vec,
+                                 float* const vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, 16>(sycl::queue& q,
+                                  const float* mat,
+                                  const float* scale_vec,
+                                  float* const vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<float, 32>(sycl::queue& q,
+                                  const float* mat,
+                                  const float* scale_vec,
+                                  float* const vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, 8>(sycl::queue& q,
+                                  const double* mat,
+                                  const double* scale_vec,
+                                  double* const vec,
+                                  const uint dim,
+                                  const uint wg_size,
+                                  std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, 16>(sycl::queue& q,
+                                   const double* mat,
+                                   const double* scale_vec,
+                                   double* const vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_rows<double, 32>(sycl::queue& q,
+                                   const double* mat,
+                                   const double* scale_vec,
+                                   double* const vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 8>(sycl::queue& q,
+                   const float* vec,
+                   float* const max,
+                   const uint dim,
+                   const uint wg_size,
+                   std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 16>(sycl::queue& q,
+                    const float* vec,
+                    float* const max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<float, 32>(sycl::queue& q,
+                    const float* vec,
+                    float* const max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 8>(sycl::queue& q,
+                    const double* vec,
+                    double* const max,
+                    const uint dim,
+                    const uint wg_size,
+                    std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 16>(sycl::queue& q,
+                     const double* vec,
+                     double* const max,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template sycl::event
+find_max<double, 32>(sycl::queue& q,
+                     const double* vec,
+                     double* const max,
+                     const uint dim,
+                     const uint wg_size,
+                     std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 8>(sycl::queue& q,
+                               const float* vec,
+                               const float* max,
+                               float* const eigen_vec,
+                               const uint dim,
+                               const uint wg_size,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 16>(sycl::queue& q,
+                                const float* vec,
+                                const float* max,
+                                float* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<float, 32>(sycl::queue& q,
+                                const float* vec,
+                                const float* max,
+                                float* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 8>(sycl::queue& q,
+                                const double* vec,
+                                const double* max,
+                                double* const eigen_vec,
+                                const uint dim,
+                                const uint wg_size,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 16>(sycl::queue& q,
+                                 const double* vec,
+                                 const double* max,
+                                 double* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+compute_eigen_vector<double, 32>(sycl::queue& q,
+                                 const double* vec,
+                                 const double* max,
+                                 double* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 std::vector<sycl::event> evts);
+
+template sycl::event
+initialise_eigen_vector<float>(sycl::queue& q,
+                               float* const vec,
+                               const uint dim,
+                               std::vector<sycl::event> evts);
+
+template sycl::event
+initialise_eigen_vector<double>(sycl::queue& q,
+                                double* const vec,
+                                const uint dim,
+                                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 8>(sycl::queue& q,
+               const float* vec,
+               uint* const ret,
+               const uint dim,
+               const uint wg_size,
+               std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 16>(sycl::queue& q,
+                const float* vec,
+                uint* const ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<float, 32>(sycl::queue& q,
+                const float* vec,
+                uint* const ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 8>(sycl::queue& q,
+                const double* vec,
+                uint* const ret,
+                const uint dim,
+                const uint wg_size,
+                std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 16>(sycl::queue& q,
+                 const double* vec,
+                 uint* const ret,
+                 const uint dim,
+                 const uint wg_size,
+                 std::vector<sycl::event> evts);
+
+template sycl::event
+stop<double, 32>(sycl::queue& q,
+                 const double* vec,
+                 uint* const ret,
+                 const uint dim,
+                 const uint wg_size,
+                 std::vector<sycl::event> evts);
@@ -0,0 +1,129 @@
+#include "small_similarity_transform.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+template<typename T, uint N>
+static int64_t
+small_similarity_transform_impl(const T* mat,
+                                T* const eigen_val,
+                                T* const eigen_vec,
+                                const layout_t layout,
+                                uint* const iter_count)
+{
+  T mat_[N * N];
+  T vec[N];
+  T sum[N];
+
+  for (uint r = 0; r < N; r++) {
+#pragma unroll
+    for (uint c = 0; c < N; c++) {
+      mat_[r * N + c] =
+        layout == layout_t::col_major ? mat[c * N + r] : mat[r * N + c];
+    }
+    vec[r] = T(1);
+  }
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  uint i = 0;
+  for (; i < MAX_ITR; i++) {
+    T max_sum = T(0);
+
+    // row sums of implicitly scaled matrix D^-1 A D
+    for (uint r = 0; r < N; r++) {
+      T s = T(0);
+#pragma unroll
+      for (uint c = 0; c < N; c++) {
+        s += mat_[r * N + c] * vec[c];
+      }
+      sum[r] = s / vec[r];
+      max_sum = std::max(max_sum, sum[r]);
+    }
+
+    bool res = true;
+#pragma unroll
+    for (uint r = 0; r < N; r++) {
+      vec[r] *= (sum[r] / max_sum);
+      res &= std::abs(sum[r] - sum[(r + 1) % N]) < EPS_T<T>;
+    }
+
+    if (res) {
+      break;
+    }
+  }
+  *iter_count = i;
+
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  *eigen_val = sum[0];
+  for (uint r = 0; r < N; r++) {
+    eigen_vec[r] = vec[r];
+  }
+
+  // whole solve takes microseconds, which would be all 0 in milliseconds
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+    .count();
+}
+
+template<typename T>
+bool
+small_similarity_transform(const T* mat,
+                           T* const eigen_val,
+                           T* const eigen_vec,
+                           const uint dim,
+                           const layout_t layout,
+                           uint* const iter_count,
+                           int64_t* const ts)
+{
+  auto f = [&](auto n) {
+    *ts = small_similarity_transform_impl<T, decltype(n)::value>(
+      mat, eigen_val, eigen_vec, layout, iter_count);
+    return true;
+  };
+
+  switch (dim) {
+    case 2:
+      return f(std::integral_constant<uint, 2>{});
+    case 3:
+      return f(std::integral_constant<uint, 3>{});
+    case 4:
+      return f(std::integral_constant<uint, 4>{});
+    case 5:
+      return f(std::integral_constant<uint, 5>{});
+    case 6:
+      return f(std::integral_constant<uint, 6>{});
+    case 7:
+      return f(std::integral_constant<uint, 7>{});
+    case 8:
+      return f(std::integral_constant<uint, 8>{});
+    case 16:
+      return f(std::integral_constant<uint, 16>{});
+    case 32:
+      return f(std::integral_constant<uint, 32>{});
+    case 64:
+      return f(std::integral_constant<uint, 64>{});
+    default:
+      return false;
+  }
+}
+
+template bool
+small_similarity_transform<float>(const float* mat,
+                                  float* const eigen_val,
+                                  float* const eigen_vec,
+                                  const uint dim,
+                                  const layout_t layout,
+                                  uint* const iter_count,
+                                  int64_t* const ts);
+
+template bool
+small_similarity_transform<double>(const double* mat,
+                                   double* const eigen_val,
+                                   double* const eigen_vec,
+                                   const uint dim,
+                                   const layout_t layout,
+                                   uint* const iter_count,
+                                   int64_t* const ts);
@@ -0,0 +1,234 @@
+#include "solver_pool.hpp"
+#include "autotune.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+SlotQueue::SlotQueue(const uint capacity)
+{
+  size_t cap = 1;
+  while (cap < capacity) {
+    cap <<= 1;
+  }
+
+  mask_ = cap - 1;
+  cells_ = std::make_unique<cell_t[]>(cap);
+  for (size_t i = 0; i < cap; i++) {
+    cells_[i].seq.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool
+SlotQueue::push(const uint slot)
+{
+  size_t pos = tail_.load(std::memory_order_relaxed);
+
+  while (true) {
+    cell_t& cell = cells_[pos & mask_];
+    const size_t seq = cell.seq.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+    if (diff == 0) {
+      // cell is free for this lap, claim it by moving tail
+      if (tail_.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+        cell.slot = slot;
+        cell.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // full
+      return false;
+    } else {
+      pos = tail_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool
+SlotQueue::pop(uint* const slot)
+{
+  size_t pos = head_.load(std::memory_order_relaxed);
+
+  while (true) {
+    cell_t& cell = cells_[pos & mask_];
+    const size_t seq = cell.seq.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (diff == 0) {
+      if (head_.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+        *slot = cell.slot;
+        // cell can be reused by producer, one lap later
+        cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // empty
+      return false;
+    } else {
+      pos = head_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template<typename T>
+SolverPool<T>::SolverPool(const sycl::device& d,
+                          const uint slots,
+                          const uint max_dim)
+  : max_dim_{ max_dim }
+  , busy_ns_{ std::make_unique<std::atomic<uint64_t>[]>(slots) }
+  , free_{ slots }
+  , created_{ std::chrono::steady_clock::now() }
+{
+  // no slot would ever be free, so first solve would wait forever
+  if (slots == 0) {
+    throw std::invalid_argument("solver pool needs at least one slot");
+  }
+
+  // all slots share one context, so that it's created only once
+  sycl::context c{ d };
+
+  for (uint i = 0; i < slots; i++) {
+    sycl::queue q{ c, d };
+    solvers_.push_back(std::make_unique<EigenSolver<T>>(q, max_dim));
+
+    busy_ns_[i].store(0);
+    free_.push(i);
+  }
+}
+
+template<typename T>
+int64_t
+SolverPool<T>::solve(const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     uint* const iter_count)
+{
+  return solve(
+    mat, eigen_val, eigen_vec, dim, layout_t::row_major, iter_count);
+}
+
+template<typename T>
+int64_t
+SolverPool<T>::solve(const T* mat,
+                     T* const eigen_val,
+                     T* const eigen_vec,
+                     const uint dim,
+                     const layout_t layout,
+                     uint* const iter_count)
+{
+  // rejected up front, same as `EigenSolver::solve` would, but without
+  // taking small path or waiting for a slot
+  if (dim > max_dim_) {
+    return -1;
+  }
+
+  // fixed small dimensions are solved on calling thread, without
+  // holding a slot
+  int64_t ts = 0;
+  if (small_similarity_transform(
+        mat, eigen_val, eigen_vec, dim, layout, iter_count, &ts)) {
+    completed_.fetch_add(1);
+    return ts / 1000;
+  }
+
+  const uint slot = acquire();
+  EigenSolver<T>& solver = *solvers_[slot];
+
+  tp start = std::chrono::steady_clock::now();
+
+  // tuned configuration is cached after first call, for device & dimension
+  // bucket, so this is cheap
+  const tuned_config cfg = autotune<T>(solver.queue(), dim);
+  ts = solver.solve(
+    mat, eigen_val, eigen_vec, dim, cfg.wg_size, layout, iter_count);
+
+  release(slot, start, 1);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+SolverPool<T>::solve_batched(const T* mats,
+                             T* const eigen_vals,
+                             T* const eigen_vecs,
+                             const uint batch,
+                             const uint dim,
+                             uint* const iter_counts)
+{
+  if (dim > max_dim_) {
+    return -1;
+  }
+
+  const uint slot = acquire();
+  EigenSolver<T>& solver = *solvers_[slot];
+
+  tp start = std::chrono::steady_clock::now();
+
+  // one work group per matrix, so it's sized by matrix, not by autotuner;
+  // whole subgroups, upto one row per work item
+  const uint wg_size = std::min(256u, (dim + 31u) / 32u * 32u);
+  int64_t ts = batched_similarity_transform(solver.queue(),
+                                            mats,
+                                            eigen_vals,
+                                            eigen_vecs,
+                                            batch,
+                                            dim,
+                                            wg_size,
+                                            iter_counts);
+
+  release(slot, start, batch);
+
+  return ts;
+}
+
+template<typename T>
+uint
+SolverPool<T>::acquire()
+{
+  uint slot = 0;
+  if (!free_.pop(&slot)) {
+    waiting_.fetch_add(1);
+    while (!free_.pop(&slot)) {
+      std::this_thread::yield();
+    }
+    waiting_.fetch_sub(1);
+  }
+  in_flight_.fetch_add(1);
+
+  return slot;
+}
+
+template<typename T>
+void
+SolverPool<T>::release(const uint slot, const tp start, const uint64_t solves)
+{
+  tp end = std::chrono::steady_clock::now();
+
+  busy_ns_[slot].fetch_add(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  completed_.fetch_add(solves);
+  in_flight_.fetch_sub(1);
+
+  free_.push(slot);
+}
+
+template<typename T>
+void
+SolverPool<T>::utilization(double* const util) const
+{
+  const tp now = std::chrono::steady_clock::now();
+  const double alive =
+    (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - created_)
+      .count();
+
+  for (uint i = 0; i < slots(); i++) {
+    util[i] = alive > 0. ? (double)busy_ns_[i].load() / alive : 0.;
+  }
+}
+
+template class SolverPool<float>;
+template class SolverPool<double>;
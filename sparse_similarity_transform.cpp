@@ -0,0 +1,241 @@
+#include "sparse_similarity_transform.hpp"
+#include <chrono>
+
+typedef sycl::accessor<uint,
+                       1,
+                       sycl::access::mode::read,
+                       sycl::access::target::global_buffer>
+  global_index_reader;
+
+template<typename T>
+class kernelSumAcrossAllScaledSparseRows;
+
+template<typename T, uint SG>
+static int64_t
+sparse_similarity_transform_impl(sycl::queue& q,
+                                 const uint* row_ptr,
+                                 const uint* col_idx,
+                                 const T* vals,
+                                 const uint nnz,
+                                 T* const eigen_val,
+                                 T* const eigen_vec,
+                                 const uint dim,
+                                 const uint wg_size,
+                                 uint* const iter_count)
+{
+  // dense steps need whole work-groups, so dense vectors are padded upto
+  // next multiple of `wg_size`; padding rows repeat row 0 ( see
+  // `sum_across_scaled_sparse_rows` ), which changes neither max row sum
+  // nor outcome of cyclic adjacency check, done by `stop`
+  const uint padded = (dim + wg_size - 1) / wg_size * wg_size;
+
+  T* sum_vec = (T*)malloc(sizeof(T) * padded);
+  T* max_elm = (T*)malloc(sizeof(T) * 1);
+  uint* ret = (uint*)malloc(sizeof(uint) * 1);
+
+  int64_t ts = 0;
+
+  {
+    index_buffer_1d b_row_ptr{ row_ptr, sycl::range<1>{ dim + 1 } };
+    index_buffer_1d b_col_idx{ col_idx, sycl::range<1>{ nnz } };
+    buffer_1d_t<T> b_vals{ vals, sycl::range<1>{ nnz } };
+
+    // only first `dim` elements are copied back to `eigen_vec`, at end
+    buffer_1d_t<T> b_eigen_vec{ sycl::range<1>{ padded } };
+    buffer_1d_t<T> b_eigen_val{ eigen_val, sycl::range<1>{ 1 } };
+
+    buffer_1d_t<T> b_sum_vec{ sum_vec, sycl::range<1>{ padded } };
+    buffer_1d_t<T> b_max_elm{ max_elm, sycl::range<1>{ 1 } };
+    sycl::buffer<uint, 1> b_ret{ ret, sycl::range<1>{ 1 } };
+
+    initialise_eigen_vector(q, b_eigen_vec, padded, {});
+
+    tp start = std::chrono::steady_clock::now();
+
+    uint i = 0;
+    for (; i < MAX_ITR; i++) {
+      sum_across_scaled_sparse_rows(q,
+                                    b_row_ptr,
+                                    b_col_idx,
+                                    b_vals,
+                                    b_eigen_vec,
+                                    b_sum_vec,
+                                    dim,
+                                    wg_size,
+                                    {});
+      find_max<T, SG>(q, b_sum_vec, b_max_elm, padded, wg_size, {});
+      compute_eigen_vector<T, SG>(
+        q, b_sum_vec, b_max_elm, b_eigen_vec, padded, wg_size, {});
+      stop<T, SG>(q, b_sum_vec, b_ret, padded, wg_size, {});
+      {
+        sycl::host_accessor<uint, 1, sycl::access_mode::read> h_ret{ b_ret };
+        if (h_ret[0] == 1) {
+          break;
+        }
+      }
+    }
+    *iter_count = i;
+
+    tp end = std::chrono::steady_clock::now();
+    ts = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+           .count();
+
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_sum_vec{ b_sum_vec, h, sycl::range<1>{ 1 } };
+      global_1d_writer_t<T> acc_eigen_val{ b_eigen_val, h };
+
+      h.copy(acc_sum_vec, acc_eigen_val);
+    });
+    q.submit([&](sycl::handler& h) {
+      global_1d_reader_t<T> acc_eigen_vec{ b_eigen_vec,
+                                           h,
+                                           sycl::range<1>{ dim } };
+
+      h.copy(acc_eigen_vec, eigen_vec);
+    });
+    q.wait();
+  }
+
+  std::free(sum_vec);
+  std::free(max_elm);
+  std::free(ret);
+
+  return ts;
+}
+
+template<typename T>
+int64_t
+sparse_similarity_transform(sycl::queue& q,
+                            const uint* row_ptr,
+                            const uint* col_idx,
+                            const T* vals,
+                            const uint nnz,
+                            T* const eigen_val,
+                            T* const eigen_vec,
+                            const uint dim,
+                            const uint wg_size,
+                            uint* const iter_count)
+{
+  if (dim == 0 || wg_size == 0) {
+    return -1;
+  }
+
+  // row without any positive entry ( say dangling node of graph ) sums to
+  // 0, which zeroes its scaling factor, by which it's divided next round
+  for (uint r = 0; r < dim; r++) {
+    bool positive = false;
+    for (uint j = row_ptr[r]; j < row_ptr[r + 1] && !positive; j++) {
+      positive = vals[j] > T(0);
+    }
+    if (!positive) {
+      return -1;
+    }
+  }
+
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return sparse_similarity_transform_impl<T, decltype(sg)::value>(q,
+                                                                   row_ptr,
+                                                                   col_idx,
+                                                                   vals,
+                                                                   nnz,
+                                                                   eigen_val,
+                                                                   eigen_vec,
+                                                                   dim,
+                                                                   wg_size,
+                                                                   iter_count);
+  });
+}
+
+template<typename T>
+sycl::event
+sum_across_scaled_sparse_rows(sycl::queue& q,
+                              index_buffer_1d row_ptr,
+                              index_buffer_1d col_idx,
+                              buffer_1d_t<T> vals,
+                              buffer_1d_t<T> scale_vec,
+                              buffer_1d_t<T> vec,
+                              const uint dim,
+                              const uint wg_size,
+                              std::vector<sycl::event> evts)
+{
+  auto evt = q.submit([&](sycl::handler& h) {
+    global_index_reader acc_row_ptr{ row_ptr, h };
+    global_index_reader acc_col_idx{ col_idx, h };
+    global_1d_reader_t<T> acc_vals{ vals, h };
+    global_1d_reader_t<T> acc_scale_vec{ scale_vec, h };
+    global_1d_writer_t<T> acc_vec{ vec, h, sycl::no_init };
+
+    if (!evts.empty()) {
+      h.depends_on(evts);
+    }
+
+    // global range is rounded upto whole work-groups, so that any number
+    // of rows works with any work-group size
+    const size_t padded = (dim + wg_size - 1) / wg_size * wg_size;
+
+    // each work item owns one row, so unlike dense version, row sum
+    // is written only once & there's no need to zero it beforehand
+    h.parallel_for<kernelSumAcrossAllScaledSparseRows<T>>(
+      sycl::nd_range<1>{ sycl::range<1>{ padded }, sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) {
+        const size_t r = it.get_global_id(0);
+        // rows past last one repeat row 0
+        const size_t row = r < dim ? r : 0;
+
+        T sum = T(0);
+        for (uint j = acc_row_ptr[row]; j < acc_row_ptr[row + 1]; j++) {
+          sum += acc_vals[j] * acc_scale_vec[acc_col_idx[j]];
+        }
+
+        acc_vec[r] = sum / acc_scale_vec[row];
+      });
+  });
+
+  return evt;
+}
+
+template int64_t
+sparse_similarity_transform<float>(sycl::queue& q,
+                                   const uint* row_ptr,
+                                   const uint* col_idx,
+                                   const float* vals,
+                                   const uint nnz,
+                                   float* const eigen_val,
+                                   float* const eigen_vec,
+                                   const uint dim,
+                                   const uint wg_size,
+                                   uint* const iter_count);
+
+template int64_t
+sparse_similarity_transform<double>(sycl::queue& q,
+                                    const uint* row_ptr,
+                                    const uint* col_idx,
+                                    const double* vals,
+                                    const uint nnz,
+                                    double* const eigen_val,
+                                    double* const eigen_vec,
+                                    const uint dim,
+                                    const uint wg_size,
+                                    uint* const iter_count);
+
+template sycl::event
+sum_across_scaled_sparse_rows<float>(sycl::queue& q,
+                                     index_buffer_1d row_ptr,
+                                     index_buffer_1d col_idx,
+                                     buffer_1d_t<float> vals,
+                                     buffer_1d_t<float> scale_vec,
+                                     buffer_1d_t<float> vec,
+                                     const uint dim,
+                                     const uint wg_size,
+                                     std::vector<sycl::event> evts);
+
+template sycl::event
+sum_across_scaled_sparse_rows<double>(sycl::queue& q,
+                                      index_buffer_1d row_ptr,
+                                      index_buffer_1d col_idx,
+                                      buffer_1d_t<double> vals,
+                                      buffer_1d_t<double> scale_vec,
+                                      buffer_1d_t<double> vec,
+                                      const uint dim,
+                                      const uint wg_size,
+                                      std::vector<sycl::event> evts);
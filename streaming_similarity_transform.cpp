@@ -0,0 +1,260 @@
+#include "streaming_similarity_transform.hpp"
+#include "multi_similarity_transform.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+template<typename T, uint SG>
+static int64_t
+streaming_similarity_transform_impl(sycl::queue& q,
+                                    tile_reader_t<T> reader,
+                                    T* const eigen_val,
+                                    T* const eigen_vec,
+                                    const uint dim,
+                                    const uint tile_rows,
+                                    const uint wg_size,
+                                    uint* const iter_count)
+{
+  const size_t tile_len = (size_t)tile_rows * dim;
+  const uint tiles = (dim + tile_rows - 1) / tile_rows;
+
+  T* h_tile[2] = { sycl::malloc_host<T>(tile_len, q),
+                   sycl::malloc_host<T>(tile_len, q) };
+  T* d_tile[2] = { sycl::malloc_device<T>(tile_len, q),
+                   sycl::malloc_device<T>(tile_len, q) };
+
+  T* d_eigen_vec = sycl::malloc_device<T>(dim, q);
+  T* d_sum_vec = sycl::malloc_device<T>(dim, q);
+  T* d_max_elm = sycl::malloc_device<T>(1, q);
+  uint* d_ret = sycl::malloc_device<uint>(1, q);
+
+  // last use of each slot, by upload from pinned host memory & by
+  // row sum kernel, respectively
+  sycl::event upload_evt[2];
+  sycl::event sum_evt[2];
+
+  // scaling vector must be updated before next round's row sums
+  sycl::event vec_evt = initialise_eigen_vector(q, d_eigen_vec, dim, {});
+  bool ok = true;
+
+  tp start = std::chrono::steady_clock::now();
+
+  uint i = 0;
+  for (; i < MAX_ITR; i++) {
+    for (uint t = 0; t < tiles; t++) {
+      const uint s = t & 1;
+      const uint row_beg = t * tile_rows;
+      const uint rows = std::min(tile_rows, dim - row_beg);
+
+      // when there're at most two tiles, both stay resident in device
+      // memory after first round, nothing more to stream
+      if (i == 0 || tiles > 2) {
+        // pinned host slot can be refilled only after it's uploaded,
+        // while next tile is being read here, current one is being
+        // uploaded/ reduced by device
+        upload_evt[s].wait();
+        if (!reader(h_tile[s], row_beg, rows)) {
+          ok = false;
+          break;
+        }
+
+        // device slot is free only after row sums of tile it was
+        // holding are computed
+        upload_evt[s] = q.memcpy(
+          d_tile[s], h_tile[s], sizeof(T) * rows * dim, sum_evt[s]);
+      }
+
+      sum_evt[s] =
+        sum_across_scaled_row_block<T, SG>(q,
+                                           d_tile[s],
+                                           d_eigen_vec,
+                                           d_sum_vec + row_beg,
+                                           rows,
+                                           row_beg,
+                                           dim,
+                                           wg_size,
+                                           { upload_evt[s], vec_evt });
+    }
+
+    if (!ok) {
+      break;
+    }
+
+    sycl::event evt_0 = find_max<T, SG>(
+      q, d_sum_vec, d_max_elm, dim, wg_size, { sum_evt[0], sum_evt[1] });
+    sycl::event evt_1 = stop<T, SG>(
+      q, d_sum_vec, d_ret, dim, wg_size, { sum_evt[0], sum_evt[1] });
+    vec_evt = compute_eigen_vector<T, SG>(
+      q, d_sum_vec, d_max_elm, d_eigen_vec, dim, wg_size, { evt_0 });
+
+    uint ret = 0;
+    q.memcpy(&ret, d_ret, sizeof(uint), evt_1).wait();
+
+    if (ret == 1) {
+      break;
+    }
+  }
+  *iter_count = i;
+
+  q.wait();
+
+  tp end = std::chrono::steady_clock::now();
+  int64_t ts =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+  if (ok) {
+    q.memcpy(eigen_vec, d_eigen_vec, sizeof(T) * dim);
+    q.memcpy(eigen_val, d_sum_vec, sizeof(T) * 1);
+    q.wait();
+  }
+
+  for (uint s = 0; s < 2; s++) {
+    sycl::free(h_tile[s], q);
+    sycl::free(d_tile[s], q);
+  }
+  sycl::free(d_eigen_vec, q);
+  sycl::free(d_sum_vec, q);
+  sycl::free(d_max_elm, q);
+  sycl::free(d_ret, q);
+
+  return ok ? ts : -1;
+}
+
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               tile_reader_t<T> reader,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count)
+{
+  // checked here, not asserted, as release builds would go on dividing by
+  // zero/ launching invalid nd-range
+  const size_t max_wg_size =
+    q.get_device().get_info<sycl::info::device::max_work_group_size>();
+  if (tile_rows == 0 || tile_rows > dim || wg_size == 0 ||
+      wg_size > max_wg_size || dim % wg_size != 0) {
+    return -1;
+  }
+
+  return dispatch_sub_group_size(sub_group_size(q.get_device()), [&](auto sg) {
+    return streaming_similarity_transform_impl<T, decltype(sg)::value>(
+      q, reader, eigen_val, eigen_vec, dim, tile_rows, wg_size, iter_count);
+  });
+}
+
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               const T* mat,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count)
+{
+  tile_reader_t<T> reader = [=](T* const tile,
+                                const uint row_beg,
+                                const uint rows) {
+    memcpy(tile, mat + (size_t)row_beg * dim, sizeof(T) * rows * dim);
+    return true;
+  };
+
+  return streaming_similarity_transform(
+    q, reader, eigen_val, eigen_vec, dim, tile_rows, wg_size, iter_count);
+}
+
+template<typename T>
+int64_t
+streaming_similarity_transform(sycl::queue& q,
+                               const char* path,
+                               const size_t offset,
+                               T* const eigen_val,
+                               T* const eigen_vec,
+                               const uint dim,
+                               const uint tile_rows,
+                               const uint wg_size,
+                               uint* const iter_count)
+{
+  std::ifstream f{ path, std::ios::binary };
+  if (!f) {
+    return -1;
+  }
+
+  tile_reader_t<T> reader = [&f, offset, dim](T* const tile,
+                                              const uint row_beg,
+                                              const uint rows) {
+    f.seekg(offset + (size_t)row_beg * dim * sizeof(T));
+    f.read(reinterpret_cast<char*>(tile), sizeof(T) * rows * dim);
+    return f.good();
+  };
+
+  return streaming_similarity_transform(
+    q, reader, eigen_val, eigen_vec, dim, tile_rows, wg_size, iter_count);
+}
+
+template int64_t
+streaming_similarity_transform<float>(sycl::queue& q,
+                                      tile_reader_t<float> reader,
+                                      float* const eigen_val,
+                                      float* const eigen_vec,
+                                      const uint dim,
+                                      const uint tile_rows,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+streaming_similarity_transform<double>(sycl::queue& q,
+                                       tile_reader_t<double> reader,
+                                       double* const eigen_val,
+                                       double* const eigen_vec,
+                                       const uint dim,
+                                       const uint tile_rows,
+                                       const uint wg_size,
+                                       uint* const iter_count);
+
+template int64_t
+streaming_similarity_transform<float>(sycl::queue& q,
+                                      const float* mat,
+                                      float* const eigen_val,
+                                      float* const eigen_vec,
+                                      const uint dim,
+                                      const uint tile_rows,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+streaming_similarity_transform<double>(sycl::queue& q,
+                                       const double* mat,
+                                       double* const eigen_val,
+                                       double* const eigen_vec,
+                                       const uint dim,
+                                       const uint tile_rows,
+                                       const uint wg_size,
+                                       uint* const iter_count);
+
+template int64_t
+streaming_similarity_transform<float>(sycl::queue& q,
+                                      const char* path,
+                                      const size_t offset,
+                                      float* const eigen_val,
+                                      float* const eigen_vec,
+                                      const uint dim,
+                                      const uint tile_rows,
+                                      const uint wg_size,
+                                      uint* const iter_count);
+
+template int64_t
+streaming_similarity_transform<double>(sycl::queue& q,
+                                       const char* path,
+                                       const size_t offset,
+                                       double* const eigen_val,
+                                       double* const eigen_vec,
+                                       const uint dim,
+                                       const uint tile_rows,
+                                       const uint wg_size,
+                                       uint* const iter_count);
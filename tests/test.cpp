@@ -1,6 +1,24 @@
+#include "async_similarity_transform.hpp"
+#include "autotune.hpp"
+#include "batched_similarity_transform.hpp"
+#include "eigen_solver.hpp"
+#include "matrix_io.hpp"
+#include "mixed_similarity_transform.hpp"
+#include "multi_similarity_transform.hpp"
+#include "native_similarity_transform.hpp"
 #include "similarity_transform.hpp"
+#include "small_similarity_transform.hpp"
+#include "solver_pool.hpp"
+#include "sparse_similarity_transform.hpp"
+#include "streaming_similarity_transform.hpp"
 #include "utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 using namespace sycl;
 
@@ -72,6 +90,49 @@ main()
   }
   std::cout << "stopping criteria test result [fail]: " << *ret << std::endl;
 
+  {
+    // stop criteria, compiled for each sub-group size this device supports;
+    // only violation in fail data is between last & first element, which is
+    // seen by last lane of some subgroup, so boundary handling gets tested
+    const std::vector<size_t> sizes =
+      d.get_info<info::device::sub_group_sizes>();
+
+    for (const uint sg_size : { 8u, 16u, 32u }) {
+      if (std::find(sizes.begin(), sizes.end(), sg_size) == sizes.end()) {
+        continue;
+      }
+
+      dispatch_sub_group_size(sg_size, [&](auto sg) {
+        constexpr uint SG = decltype(sg)::value;
+
+        stop_criteria_test_success_data(q, vec, N, B, {}).wait();
+        {
+          buffer_1d buf_vec{ vec, sycl::range<1>{ N } };
+          buffer<uint, 1> buf_ret{ ret, range<1>{ 1 } };
+
+          stop<float, SG>(q, buf_vec, buf_ret, N, B, {}).wait();
+        }
+        assert(*ret == 1);
+
+        stop_criteria_test_fail_data(q, vec, N, B, {}).wait();
+        {
+          buffer_1d buf_vec{ vec, sycl::range<1>{ N } };
+          buffer<uint, 1> buf_ret{ ret, range<1>{ 1 } };
+
+          stop<float, SG>(q, buf_vec, buf_ret, N, B, {}).wait();
+        }
+        assert(*ret == 0);
+      });
+    }
+    // unsupported size isn't dispatched at all
+    const int64_t unsupported =
+      dispatch_sub_group_size(0, [&](auto) { return int64_t(0); });
+    assert(unsupported == -1);
+
+    std::cout << "stopping criteria works for all sub-group sizes, "
+              << "dispatching " << sub_group_size(d) << std::endl;
+  }
+
   std::free(mat);
   std::free(vec);
   std::free(eigen_vec);
@@ -103,6 +164,923 @@ main()
   std::cout << "similarity transform worked !\t\t[ " << iter_count
             << " iterations ]\t\t" << ts << " ms" << std::endl;
 
+  {
+    // known eigen value must be enclosed by min & max of final row sums,
+    // which are within convergence tolerance of each other
+    float bounds[2] = { 0.f, 0.f };
+
+    similarity_transform<float>(
+      q, mat, eigen_val, eigen_vec, nullptr, bounds, 3, 3, &iter_count);
+    assert(bounds[0] <= 7.53114f + EPS && 7.53114f - EPS <= bounds[1]);
+    assert(bounds[1] - bounds[0] < 2 * EPS);
+
+    implicit_similarity_transform<float>(
+      q, mat, eigen_val, eigen_vec, nullptr, bounds, 3, 3, &iter_count);
+    assert(bounds[0] <= 7.53114f + EPS && 7.53114f - EPS <= bounds[1]);
+    assert(bounds[1] - bounds[0] < 2 * EPS);
+
+    std::cout << "eigen value bounds worked !\t\t[ " << bounds[0] << ", "
+              << bounds[1] << " ]" << std::endl;
+  }
+
+  {
+    // same matrix, scaled up, where fixed absolute tolerance is meaningless;
+    // relative gap of row sums must be within requested tolerance
+    float* scaled = (float*)malloc(sizeof(float) * 3 * 3);
+    for (uint i = 0; i < 3 * 3; i++) {
+      *(scaled + i) = *(mat + i) * 1e4f;
+    }
+
+    solver_options_t<float> opts;
+    opts.abs_tol = 0.f;
+    opts.rel_tol = 1e-5f;
+    opts.rule = stop_rule_t::relative_gap;
+    float bounds[2] = { 0.f, 0.f };
+
+    similarity_transform<float>(q,
+                                scaled,
+                                eigen_val,
+                                eigen_vec,
+                                nullptr,
+                                bounds,
+                                3,
+                                3,
+                                opts,
+                                &iter_count);
+    assert(iter_count < opts.max_itr);
+    assert(bounds[1] - bounds[0] <= opts.rel_tol * bounds[1]);
+    assert(abs(*eigen_val / 1e4f - 7.53114) < EPS);
+
+    implicit_similarity_transform<float>(q,
+                                         scaled,
+                                         eigen_val,
+                                         eigen_vec,
+                                         nullptr,
+                                         bounds,
+                                         3,
+                                         3,
+                                         opts,
+                                         &iter_count);
+    assert(iter_count < opts.max_itr);
+    assert(bounds[1] - bounds[0] <= opts.rel_tol * bounds[1]);
+    assert(abs(*eigen_val / 1e4f - 7.53114) < EPS);
+
+    std::cout << "relative gap stopping rule worked !\t[ " << iter_count
+              << " iterations ]" << std::endl;
+
+    // zero tolerance never converges, so iteration cap must be honoured
+    opts.rel_tol = 0.f;
+    opts.max_itr = 2;
+    implicit_similarity_transform<float>(q,
+                                         scaled,
+                                         eigen_val,
+                                         eigen_vec,
+                                         nullptr,
+                                         nullptr,
+                                         3,
+                                         3,
+                                         opts,
+                                         &iter_count);
+    assert(iter_count == 2);
+
+    // deadline, which has already passed, still gets one round, bounds of
+    // which must enclose eigen value; solve stopping after it counts no
+    // iterations, same as one converging in first round
+    solver_options_t<float> late;
+    late.deadline = std::chrono::steady_clock::now();
+
+    similarity_transform<float>(q,
+                                mat,
+                                eigen_val,
+                                eigen_vec,
+                                nullptr,
+                                bounds,
+                                3,
+                                3,
+                                late,
+                                &iter_count);
+    assert(iter_count == 0);
+    assert(bounds[0] <= 7.53114 && 7.53114 <= bounds[1]);
+
+    implicit_similarity_transform<float>(q,
+                                         mat,
+                                         eigen_val,
+                                         eigen_vec,
+                                         nullptr,
+                                         bounds,
+                                         3,
+                                         3,
+                                         late,
+                                         &iter_count);
+    assert(iter_count == 0);
+    assert(bounds[0] <= 7.53114 && 7.53114 <= bounds[1]);
+
+    std::cout << "deadline bounded solve worked !\t\t[ " << bounds[0] << ", "
+              << bounds[1] << " ]" << std::endl;
+
+    std::free(scaled);
+  }
+
+  ts = fused_similarity_transform(
+    q, mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+  assert(abs(*eigen_val - 7.53114) < EPS);
+  assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+  assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+  assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+  std::cout << "fused similarity transform worked !\t[ " << iter_count
+            << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+  ts = implicit_similarity_transform(
+    q, mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+  assert(abs(*eigen_val - 7.53114) < EPS);
+  assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+  assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+  assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+  std::cout << "implicit similarity transform worked !\t[ " << iter_count
+            << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+  ts = accelerated_similarity_transform(
+    q, mat, eigen_val, eigen_vec, 3, 3, 3, &iter_count);
+
+  assert(abs(*eigen_val - 7.53114) < EPS);
+  assert(abs(*(eigen_vec + 0) / *(eigen_vec + 2) - 0.395081) < EPS);
+  assert(abs(*(eigen_vec + 1) / *(eigen_vec + 2) - 0.580323) < EPS);
+  std::cout << "accelerated similarity transform worked !\t[ " << iter_count
+            << " iterations ]\t" << ts << " ms" << std::endl;
+
+  // iteration count must be exact, even though convergence is only
+  // checked on host after every few rounds
+  uint spec_iter_count = 0;
+  ts = speculative_similarity_transform(
+    q, mat, eigen_val, eigen_vec, 3, 3, 4, &spec_iter_count);
+
+  assert(spec_iter_count == iter_count);
+  assert(abs(*eigen_val - 7.53114) < EPS);
+  assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+  assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+  assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+  std::cout << "speculative similarity transform worked !\t[ "
+            << spec_iter_count << " iterations ]\t\t" << ts << " ms"
+            << std::endl;
+
+  if (d.has(aspect::fp16)) {
+    // matrix is stored in half precision, while row sums & eigen vector
+    // are kept in single precision; entries of this matrix are exactly
+    // representable in half, but tolerance is kept at what half offers
+    const float HALF_EPS = 1e-2f;
+
+    ts = mixed_similarity_transform<sycl::half>(
+      q, mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val - 7.53114) < HALF_EPS);
+    assert(abs(*(eigen_vec + 0) - 0.394074) < HALF_EPS);
+    assert(abs(*(eigen_vec + 1) - 0.578844) < HALF_EPS);
+    assert(abs(*(eigen_vec + 2) - 0.997451) < HALF_EPS);
+    std::cout << "mixed precision similarity transform worked !\t[ "
+              << iter_count << " iterations ]\t" << ts << " ms" << std::endl;
+  }
+
+  // fixed small dimension is handed to specialised host solver, skipping
+  // autotuner; see below for one which is tuned
+  ts = similarity_transform(q, mat, eigen_val, eigen_vec, 3, &iter_count);
+
+  assert(abs(*eigen_val - 7.53114) < EPS);
+  assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+  assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+  assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+  std::cout << "small autotuned transform worked !\t[ " << iter_count
+            << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+  {
+    // tuned work-group size must be usable for this dimension, and
+    // whichever engine won, it should agree with plain one; dimension
+    // has no specialised solver, so tuned engine does run
+    const uint dim = 128;
+
+    float* h_mat = (float*)malloc(sizeof(float) * dim * dim);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float* h_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+
+    generate_hilbert_matrix(q, h_mat, dim);
+
+    const tuned_config cfg = autotune<float>(q, dim);
+    assert(cfg.wg_size > 0 && dim % cfg.wg_size == 0);
+
+    // second lookup is served from memoised/ on-disk cache
+    const tuned_config cfg_ = autotune<float>(q, dim);
+    assert(cfg_.wg_size == cfg.wg_size && cfg_.engine == cfg.engine);
+
+    similarity_transform(
+      q, h_mat, &ref_eigen_val, ref_eigen_vec, dim, 32, &iter_count);
+    ts = similarity_transform(
+      q, h_mat, eigen_val, h_eigen_vec, dim, &iter_count);
+
+    assert(abs(*eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(h_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+    std::cout << "autotuner worked !\t\t\t[ wg size " << cfg.wg_size
+              << " ]\t\t" << ts << " ms" << std::endl;
+
+    std::free(h_mat);
+    std::free(ref_eigen_vec);
+    std::free(h_eigen_vec);
+  }
+
+  {
+    // workspace is sized for larger matrices, but reused for
+    // repeated solves of small one
+    EigenSolver<float> solver{ q, N };
+
+    for (uint i = 0; i < 2; i++) {
+      ts = solver.solve(mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+      assert(abs(*eigen_val - 7.53114) < EPS);
+      assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+      assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+      assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+    }
+    std::cout << "eigen solver worked !\t\t\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+    // same matrix, stored column major
+    float* mat_t = (float*)malloc(sizeof(float) * 3 * 3);
+    for (uint i = 0; i < 3; i++) {
+      for (uint j = 0; j < 3; j++) {
+        *(mat_t + j * 3 + i) = *(mat + i * 3 + j);
+      }
+    }
+
+    ts = solver.solve(
+      mat_t, eigen_val, eigen_vec, 3, 3, layout_t::col_major, &iter_count);
+
+    assert(abs(*eigen_val - 7.53114) < EPS);
+    assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+    assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+    assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+
+    std::free(mat_t);
+  }
+
+  if (d.has(aspect::fp64)) {
+    // same matrix, but in double precision, where tolerance is much tighter,
+    // so checking eigen equation A.v = λ.v instead of rounded values
+    double* mat_d = (double*)malloc(sizeof(double) * 3 * 3);
+    double* eigen_val_d = (double*)malloc(sizeof(double) * 1);
+    double* eigen_vec_d = (double*)malloc(sizeof(double) * 3 * 1);
+
+    for (uint i = 0; i < 3 * 3; i++) {
+      *(mat_d + i) = (double)*(mat + i);
+    }
+
+    ts = similarity_transform(
+      q, mat_d, eigen_val_d, eigen_vec_d, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val_d - 7.531128874149275) < 1e-6);
+    for (uint i = 0; i < 3; i++) {
+      double av = 0.;
+      for (uint j = 0; j < 3; j++) {
+        av += *(mat_d + i * 3 + j) * *(eigen_vec_d + j);
+      }
+      assert(abs(av - *eigen_val_d * *(eigen_vec_d + i)) < 1e-6);
+    }
+    std::cout << "double similarity transform worked !\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+    std::free(mat_d);
+    std::free(eigen_val_d);
+    std::free(eigen_vec_d);
+  }
+
+  {
+    // small matrices are solved by one subgroup each
+    const uint batch = 4;
+
+    float* mats = (float*)malloc(sizeof(float) * batch * 3 * 3);
+    float* eigen_vals = (float*)malloc(sizeof(float) * batch);
+    float* eigen_vecs = (float*)malloc(sizeof(float) * batch * 3);
+    uint* iter_counts = (uint*)malloc(sizeof(uint) * batch);
+
+    for (uint b = 0; b < batch; b++) {
+      memcpy(mats + b * 3 * 3, mat, sizeof(float) * 3 * 3);
+    }
+
+    ts = batched_similarity_transform(
+      q, mats, eigen_vals, eigen_vecs, batch, 3, 3, iter_counts);
+
+    for (uint b = 0; b < batch; b++) {
+      assert(abs(*(eigen_vals + b) - 7.53114) < EPS);
+      assert(abs(*(eigen_vecs + b * 3 + 0) - 0.394074) < EPS);
+      assert(abs(*(eigen_vecs + b * 3 + 1) - 0.578844) < EPS);
+      assert(abs(*(eigen_vecs + b * 3 + 2) - 0.997451) < EPS);
+    }
+    std::cout << "batched similarity transform worked !\t[ "
+              << *(iter_counts + 0) << " iterations ]\t\t" << ts << " ms"
+              << std::endl;
+
+    std::free(mats);
+    std::free(eigen_vals);
+    std::free(eigen_vecs);
+    std::free(iter_counts);
+  }
+
+  {
+    // larger matrices are solved by one work group each, results
+    // must match with what's computed when solved one at a time
+    const uint batch = 2;
+    const uint dim = 64;
+
+    float* mats = (float*)malloc(sizeof(float) * batch * dim * dim);
+    float* eigen_vals = (float*)malloc(sizeof(float) * batch);
+    float* eigen_vecs = (float*)malloc(sizeof(float) * batch * dim);
+    uint* iter_counts = (uint*)malloc(sizeof(uint) * batch);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+    uint ref_iter_count = 0;
+
+    for (uint b = 0; b < batch; b++) {
+      generate_hilbert_matrix(q, mats + b * dim * dim, dim);
+    }
+
+    implicit_similarity_transform(
+      q, mats, &ref_eigen_val, ref_eigen_vec, dim, 32, &ref_iter_count);
+    batched_similarity_transform(
+      q, mats, eigen_vals, eigen_vecs, batch, dim, 32, iter_counts);
+
+    for (uint b = 0; b < batch; b++) {
+      assert(abs(*(eigen_vals + b) - ref_eigen_val) < EPS);
+      for (uint i = 0; i < dim; i++) {
+        assert(abs(*(eigen_vecs + b * dim + i) - *(ref_eigen_vec + i)) < EPS);
+      }
+    }
+    std::cout << "batched similarity transform matches !\t[ "
+              << *(iter_counts + 0) << " iterations ]" << std::endl;
+
+    std::free(mats);
+    std::free(eigen_vals);
+    std::free(eigen_vecs);
+    std::free(iter_counts);
+    std::free(ref_eigen_vec);
+  }
+
+  {
+    // native backend, on host, without SYCL; odd dimension exercises
+    // tails of vectorized loops
+    float native_eigen_val = 0.f;
+    float native_eigen_vec[3];
+    uint native_iter_count = 0;
+
+    native_similarity_transform(
+      mat, &native_eigen_val, native_eigen_vec, 3, &native_iter_count);
+    assert(abs(native_eigen_val - 7.53114) < EPS);
+    assert(abs(native_eigen_vec[0] / native_eigen_vec[2] - 0.395081) < EPS);
+    assert(abs(native_eigen_vec[1] / native_eigen_vec[2] - 0.580323) < EPS);
+
+    // must agree with SYCL implicit engine, on larger matrix
+    const uint dim = 100;
+    float* hilbert = (float*)malloc(sizeof(float) * dim * dim);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float* hilbert_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+    float hilbert_eigen_val = 0.f;
+    uint ref_iter_count = 0;
+
+    generate_hilbert_matrix(q, hilbert, dim);
+    implicit_similarity_transform(
+      q, hilbert, &ref_eigen_val, ref_eigen_vec, dim, 4, &ref_iter_count);
+    native_similarity_transform(
+      hilbert, &hilbert_eigen_val, hilbert_eigen_vec, dim, &native_iter_count);
+
+    assert(abs(hilbert_eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(hilbert_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+    std::cout << "native similarity transform worked !\t[ "
+              << native_simd_isa() << ", " << native_iter_count
+              << " iterations ]" << std::endl;
+
+    std::free(hilbert);
+    std::free(ref_eigen_vec);
+    std::free(hilbert_eigen_vec);
+  }
+
+  {
+    // compile-time specialised solver, both layouts of same matrix
+    float small_eigen_val = 0.f;
+    float small_eigen_vec[3];
+    uint small_iter_count = 0;
+    float mat_t[3 * 3];
+    for (uint i = 0; i < 3; i++) {
+      for (uint j = 0; j < 3; j++) {
+        mat_t[j * 3 + i] = *(mat + i * 3 + j);
+      }
+    }
+
+    for (const float* m : { (const float*)mat, (const float*)mat_t }) {
+      const layout_t layout =
+        m == mat ? layout_t::row_major : layout_t::col_major;
+
+      const bool solved = small_similarity_transform(m,
+                                                     &small_eigen_val,
+                                                     small_eigen_vec,
+                                                     3,
+                                                     layout,
+                                                     &small_iter_count,
+                                                     &ts);
+      assert(solved);
+      assert(abs(small_eigen_val - 7.53114) < EPS);
+      assert(abs(small_eigen_vec[0] - 0.394074) < EPS);
+      assert(abs(small_eigen_vec[1] - 0.578844) < EPS);
+      assert(abs(small_eigen_vec[2] - 0.997451) < EPS);
+    }
+
+    // dimension without specialised solver is left to generic engines
+    const bool solved = small_similarity_transform(mat,
+                                                   &small_eigen_val,
+                                                   small_eigen_vec,
+                                                   9,
+                                                   layout_t::row_major,
+                                                   &small_iter_count,
+                                                   &ts);
+    assert(!solved);
+
+    // must agree with generic implicit engine
+    const uint dim = 16;
+    float* hilbert = (float*)malloc(sizeof(float) * dim * dim);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float* hilbert_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+    float hilbert_eigen_val = 0.f;
+    uint ref_iter_count = 0;
+
+    generate_hilbert_matrix(q, hilbert, dim);
+    implicit_similarity_transform(
+      q, hilbert, &ref_eigen_val, ref_eigen_vec, dim, dim, &ref_iter_count);
+    small_similarity_transform(hilbert,
+                               &hilbert_eigen_val,
+                               hilbert_eigen_vec,
+                               dim,
+                               layout_t::row_major,
+                               &small_iter_count,
+                               &ts);
+
+    assert(abs(hilbert_eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(hilbert_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+    std::cout << "small similarity transform worked !\t[ "
+              << small_iter_count << " iterations ]\t\t" << ts << " us"
+              << std::endl;
+
+    std::free(hilbert);
+    std::free(ref_eigen_vec);
+    std::free(hilbert_eigen_vec);
+  }
+
+  {
+    // dense 3 x 3 matrix, kept in compressed sparse row format
+    uint row_ptr[] = { 0, 3, 6, 9 };
+    uint col_idx[] = { 0, 1, 2, 0, 1, 2, 0, 1, 2 };
+
+    ts = sparse_similarity_transform(
+      q, row_ptr, col_idx, mat, 9, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val - 7.53114) < EPS);
+    assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+    assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+    assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+    std::cout << "sparse similarity transform worked !\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+  }
+
+  {
+    // prime number of rows, with work-group size not dividing it, must
+    // agree with dense run of same tridiagonal matrix
+    const uint dim = 5;
+    float dense[dim * dim] = { 0.f };
+    uint row_ptr[dim + 1] = { 0 };
+    uint col_idx[3 * dim];
+    float vals[3 * dim];
+
+    uint nnz = 0;
+    for (uint r = 0; r < dim; r++) {
+      for (uint c = (r > 0 ? r - 1 : 0); c <= r + 1 && c < dim; c++) {
+        dense[r * dim + c] = 1.f + r + c;
+        col_idx[nnz] = c;
+        vals[nnz] = dense[r * dim + c];
+        nnz++;
+      }
+      row_ptr[r + 1] = nnz;
+    }
+
+    float ref_eigen_val = 0.f;
+    float ref_eigen_vec[dim];
+    float sparse_eigen_vec[dim];
+    uint ref_iter_count = 0;
+
+    implicit_similarity_transform(
+      q, dense, &ref_eigen_val, ref_eigen_vec, dim, dim, &ref_iter_count);
+    ts = sparse_similarity_transform(q,
+                                     row_ptr,
+                                     col_idx,
+                                     vals,
+                                     nnz,
+                                     eigen_val,
+                                     sparse_eigen_vec,
+                                     dim,
+                                     4,
+                                     &iter_count);
+
+    assert(ts >= 0);
+    assert(abs(*eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(sparse_eigen_vec[i] - ref_eigen_vec[i]) < EPS);
+    }
+
+    // last row made dangling, which can't be solved
+    row_ptr[dim] = row_ptr[dim - 1];
+    const int64_t dangling_ts = sparse_similarity_transform(q,
+                                                            row_ptr,
+                                                            col_idx,
+                                                            vals,
+                                                            nnz,
+                                                            eigen_val,
+                                                            sparse_eigen_vec,
+                                                            dim,
+                                                            4,
+                                                            &iter_count);
+    assert(dangling_ts == -1);
+
+    std::cout << "sparse, uneven work-groups worked !\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+  }
+
+  {
+    // rows partitioned unevenly across 3 queues ( 4 blocks of 16 rows ),
+    // here all on same device, must agree with single queue run
+    const uint dim = 64;
+    const uint wg_size = 16;
+    std::vector<queue> qs{ q, q, q };
+
+    float* h_mat = (float*)malloc(sizeof(float) * dim * dim);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float* h_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+    uint ref_iter_count = 0;
+
+    generate_hilbert_matrix(q, h_mat, dim);
+
+    implicit_similarity_transform(
+      q, h_mat, &ref_eigen_val, ref_eigen_vec, dim, wg_size, &ref_iter_count);
+    ts = multi_similarity_transform(
+      qs, h_mat, eigen_val, h_eigen_vec, dim, wg_size, &iter_count);
+
+    assert(abs(*eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(h_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+    std::cout << "multi-device similarity transform matches !\t[ "
+              << iter_count << " iterations ]\t\t" << ts << " ms"
+              << std::endl;
+
+    std::free(h_mat);
+    std::free(ref_eigen_vec);
+    std::free(h_eigen_vec);
+  }
+
+  {
+    // matrix streamed in 3 tiles of 24, 24 & 16 rows, both out of host
+    // memory and file, must agree with in-memory run
+    const uint dim = 64;
+    const uint wg_size = 16;
+    const char* path = "streaming_test.bin";
+
+    float* h_mat = (float*)malloc(sizeof(float) * dim * dim);
+    float* ref_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float* h_eigen_vec = (float*)malloc(sizeof(float) * dim);
+    float ref_eigen_val = 0.f;
+    uint ref_iter_count = 0;
+
+    generate_hilbert_matrix(q, h_mat, dim);
+
+    implicit_similarity_transform(
+      q, h_mat, &ref_eigen_val, ref_eigen_vec, dim, wg_size, &ref_iter_count);
+
+    ts = streaming_similarity_transform(
+      q, h_mat, eigen_val, h_eigen_vec, dim, 24, wg_size, &iter_count);
+
+    assert(ts >= 0);
+    assert(abs(*eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(h_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+
+    {
+      std::ofstream f{ path, std::ios::binary };
+      f.write(reinterpret_cast<const char*>(h_mat),
+              sizeof(float) * dim * dim);
+    }
+
+    ts = streaming_similarity_transform(
+      q, path, 0, eigen_val, h_eigen_vec, dim, 24, wg_size, &iter_count);
+    std::remove(path);
+
+    assert(ts >= 0);
+    assert(abs(*eigen_val - ref_eigen_val) < EPS);
+    for (uint i = 0; i < dim; i++) {
+      assert(abs(*(h_eigen_vec + i) - *(ref_eigen_vec + i)) < EPS);
+    }
+
+    // bad tile height/ work-group size are refused, not asserted
+    for (const uint bad : { 0u, dim + 1 }) {
+      const int64_t bad_ts = streaming_similarity_transform(
+        q, h_mat, eigen_val, h_eigen_vec, dim, bad, wg_size, &iter_count);
+      assert(bad_ts == -1);
+    }
+    for (const uint bad : { 0u, 5u }) {
+      const int64_t bad_ts = streaming_similarity_transform(
+        q, h_mat, eigen_val, h_eigen_vec, dim, 24, bad, &iter_count);
+      assert(bad_ts == -1);
+    }
+
+    std::cout << "streaming similarity transform matches !\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+
+    std::free(h_mat);
+    std::free(ref_eigen_vec);
+    std::free(h_eigen_vec);
+  }
+
+  {
+    // 3 x 3 matrix written to file & solved straight out of mapping
+    const char* path = "matrix_test.stmx";
+    const bool written = write_matrix(path, mat, 3);
+    assert(written);
+
+    mapped_matrix_t m;
+    const bool mapped_ok = map_matrix(path, &m);
+    assert(mapped_ok);
+    assert(m.header.dim == 3);
+    assert(m.header.layout == layout_t::row_major);
+    assert((uintptr_t)m.data % MATRIX_PAYLOAD_ALIGNMENT == 0);
+    assert(matrix_data<double>(m) == nullptr);
+
+    const float* mapped = matrix_data<float>(m);
+    assert(mapped != nullptr);
+
+    ts = implicit_similarity_transform(
+      q, mapped, eigen_val, eigen_vec, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val - 7.53114) < EPS);
+    assert(abs(*(eigen_vec + 0) - 0.394074) < EPS);
+    assert(abs(*(eigen_vec + 1) - 0.578844) < EPS);
+    assert(abs(*(eigen_vec + 2) - 0.997451) < EPS);
+
+    unmap_matrix(&m);
+    assert(m.data == nullptr);
+
+    // truncated payload must be rejected
+    {
+      std::ofstream f{ path, std::ios::binary | std::ios::in | std::ios::out };
+      f.seekp(offsetof(matrix_header_t, dim));
+      const uint32_t dim = 4;
+      f.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+    }
+    const bool truncated_ok = map_matrix(path, &m);
+    assert(!truncated_ok);
+
+    // payload offset so large that offset + payload length wraps around,
+    // must be rejected too
+    {
+      std::ofstream f{ path, std::ios::binary | std::ios::in | std::ios::out };
+      const uint32_t dim = 3;
+      f.seekp(offsetof(matrix_header_t, dim));
+      f.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+
+      const uint64_t offset = ~uint64_t(0) & ~(MATRIX_PAYLOAD_ALIGNMENT - 1);
+      f.seekp(offsetof(matrix_header_t, payload_offset));
+      f.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    const bool hostile_ok = map_matrix(path, &m);
+    assert(!hostile_ok);
+
+    // dimension so large that dim x dim x element size wraps around to 0,
+    // with offset being valid again
+    {
+      std::ofstream f{ path, std::ios::binary | std::ios::in | std::ios::out };
+      const uint32_t dim = 1u << 31;
+      f.seekp(offsetof(matrix_header_t, dim));
+      f.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+
+      const uint64_t offset = MATRIX_PAYLOAD_ALIGNMENT;
+      f.seekp(offsetof(matrix_header_t, payload_offset));
+      f.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    const bool huge_dim_ok = map_matrix(path, &m);
+    assert(!huge_dim_ok);
+
+    // empty matrix isn't a matrix
+    {
+      std::ofstream f{ path, std::ios::binary | std::ios::in | std::ios::out };
+      const uint32_t dim = 0;
+      f.seekp(offsetof(matrix_header_t, dim));
+      f.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+    }
+    const bool empty_ok = map_matrix(path, &m);
+    assert(!empty_ok);
+    std::remove(path);
+
+    std::cout << "memory mapped matrix worked !\t\t[ " << iter_count
+              << " iterations ]\t\t" << ts << " ms" << std::endl;
+  }
+
+  {
+    // few solves of same matrix in flight at once, on same queue
+    const uint in_flight = 4;
+    float* eigen_vals = (float*)malloc(sizeof(float) * in_flight);
+    float* eigen_vecs = (float*)malloc(sizeof(float) * in_flight * 3);
+    uint* iter_counts = (uint*)malloc(sizeof(uint) * in_flight);
+
+    std::vector<std::future<int64_t>> solves;
+    for (uint i = 0; i < in_flight; i++) {
+      solves.push_back(async_similarity_transform(q,
+                                                  (const float*)mat,
+                                                  eigen_vals + i,
+                                                  eigen_vecs + i * 3,
+                                                  3,
+                                                  3,
+                                                  solver_options_t<float>{},
+                                                  iter_counts + i));
+    }
+
+    for (uint i = 0; i < in_flight; i++) {
+      solves[i].get();
+
+      assert(abs(*(eigen_vals + i) - 7.53114) < EPS);
+      assert(abs(*(eigen_vecs + i * 3 + 0) - 0.394074) < EPS);
+      assert(abs(*(eigen_vecs + i * 3 + 1) - 0.578844) < EPS);
+      assert(abs(*(eigen_vecs + i * 3 + 2) - 0.997451) < EPS);
+      assert(*(iter_counts + i) == *iter_counts);
+    }
+    std::cout << "asynchronous similarity transform worked !\t[ " << in_flight
+              << " in flight ]" << std::endl;
+
+    std::free(eigen_vals);
+    std::free(eigen_vecs);
+    std::free(iter_counts);
+  }
+
+  {
+    // more threads than slots, all solving at once, through shared pool;
+    // dimension has no specialised solver, so every solve holds a slot
+    const uint slots = 2;
+    const uint threads = 6;
+    const uint dim = 9;
+    SolverPool<float> pool{ d, slots, dim };
+
+    float hilbert[dim * dim];
+    float ref_val = 0.f;
+    float ref_vec[dim];
+    uint ref_itr = 0;
+
+    generate_hilbert_matrix(q, hilbert, dim);
+    implicit_similarity_transform(
+      q, hilbert, &ref_val, ref_vec, dim, dim, &ref_itr);
+
+    std::vector<uint> ok(threads, 0);
+    std::vector<std::thread> workers;
+    for (uint t = 0; t < threads; t++) {
+      workers.emplace_back([&, t]() {
+        float val = 0.f;
+        float vec[dim];
+        uint itr = 0;
+
+        for (uint r = 0; r < 4; r++) {
+          pool.solve(hilbert, &val, vec, dim, &itr);
+
+          bool same = abs(val - ref_val) < EPS;
+          for (uint i = 0; i < dim; i++) {
+            same = same && abs(vec[i] - ref_vec[i]) < EPS;
+          }
+          ok[t] += same;
+        }
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+
+    for (uint t = 0; t < threads; t++) {
+      assert(ok[t] == 4);
+    }
+    assert(pool.completed() == threads * 4);
+    assert(pool.queue_depth() == 0 && pool.in_flight() == 0);
+
+    double util[slots];
+    pool.utilization(util);
+    for (uint i = 0; i < slots; i++) {
+      assert(util[i] >= 0. && util[i] <= 1.);
+    }
+    // whole stack of matrices is solved on one slot, at once
+    float mats[4 * 3 * 3];
+    float vals[4];
+    float vecs[4 * 3];
+    uint itrs[4];
+    for (uint b = 0; b < 4; b++) {
+      memcpy(mats + b * 3 * 3, mat, sizeof(float) * 3 * 3);
+    }
+
+    pool.solve_batched(mats, vals, vecs, 4, 3, itrs);
+    for (uint b = 0; b < 4; b++) {
+      assert(abs(vals[b] - 7.53114) < EPS);
+      assert(abs(vecs[b * 3 + 0] / vecs[b * 3 + 2] - 0.395081) < EPS);
+      assert(abs(vecs[b * 3 + 1] / vecs[b * 3 + 2] - 0.580323) < EPS);
+    }
+    assert(pool.completed() == threads * 4 + 4);
+
+    // fixed small dimension is solved on calling thread, without any slot
+    {
+      float val = 0.f;
+      float vec[3];
+      uint itr = 0;
+
+      pool.solve(mat, &val, vec, 3, &itr);
+      assert(abs(val - 7.53114) < EPS);
+      assert(abs(vec[0] - 0.394074) < EPS);
+      assert(abs(vec[1] - 0.578844) < EPS);
+      assert(abs(vec[2] - 0.997451) < EPS);
+      assert(pool.completed() == threads * 4 + 5);
+      assert(pool.in_flight() == 0);
+    }
+
+    // larger than pool's workspace: refused, without solving anything
+    {
+      float val = 0.f;
+      float vec[3];
+      uint itr = 0;
+
+      const uint too_big = pool.max_dim() + 1;
+      const int64_t solve_ts = pool.solve(mat, &val, vec, too_big, &itr);
+      assert(solve_ts == -1);
+      const int64_t batch_ts =
+        pool.solve_batched(mats, vals, vecs, 1, too_big, itrs);
+      assert(batch_ts == -1);
+      assert(pool.completed() == threads * 4 + 5);
+    }
+
+    // pool without slots would block its first solve forever
+    bool refused = false;
+    try {
+      SolverPool<float> empty{ d, 0, dim };
+    } catch (const std::invalid_argument&) {
+      refused = true;
+    }
+    assert(refused);
+
+    std::cout << "solver pool worked !\t\t\t[ " << threads << " threads, "
+              << slots << " slots ]" << std::endl;
+  }
+
+  {
+    // slightly drifted matrix, solved again, starting from previous
+    // eigen vector; warm start must not take more rounds than cold one
+    float* drifted = (float*)malloc(sizeof(float) * 3 * 3);
+    float* cold_eigen_vec = (float*)malloc(sizeof(float) * 3 * 1);
+    float cold_eigen_val = 0;
+    uint cold_iter_count = 0;
+
+    memcpy(drifted, mat, sizeof(float) * 3 * 3);
+    *(drifted + 1 * 3 + 1) += 0.05f;
+
+    similarity_transform(q, mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+    similarity_transform(
+      q, drifted, &cold_eigen_val, cold_eigen_vec, 3, 3, &cold_iter_count);
+
+    // previous result is passed back in, aliasing output
+    ts = similarity_transform(
+      q, drifted, eigen_val, eigen_vec, eigen_vec, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val - cold_eigen_val) < EPS);
+    assert(iter_count <= cold_iter_count);
+
+    similarity_transform(q, mat, eigen_val, eigen_vec, 3, 3, &iter_count);
+    ts = implicit_similarity_transform(
+      q, drifted, eigen_val, eigen_vec, eigen_vec, 3, 3, &iter_count);
+
+    assert(abs(*eigen_val - cold_eigen_val) < EPS);
+    assert(iter_count <= cold_iter_count);
+
+    std::cout << "warm started similarity transform worked !\t[ "
+              << iter_count << " vs. " << cold_iter_count
+              << " iterations ]\t" << ts << " ms" << std::endl;
+
+    std::free(drifted);
+    std::free(cold_eigen_vec);
+  }
+
   std::free(mat);
   std::free(eigen_val);
   std::free(eigen_vec);
@@ -121,25 +121,27 @@ stop_criteria_test_fail_data(sycl::queue& q,
   return evt_1;
 }
 
+template<typename T>
 void
-generate_random_vector(float* const vec, const uint dim)
+generate_random_vector(T* const vec, const uint dim)
 {
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_real_distribution<float> dis(0.f, 1.f);
+  std::uniform_real_distribution<T> dis(T(0), T(1));
 
   for (uint i = 0; i < dim; i++) {
     *(vec + i) = dis(gen);
   }
 }
 
+template<typename T>
 void
-generate_hilbert_matrix(sycl::queue& q, float* const mat, const uint dim)
+generate_hilbert_matrix(sycl::queue& q, T* const mat, const uint dim)
 {
-  buffer_2d buf_mat{ mat, sycl::range<2>{ dim, dim } };
+  buffer_2d_t<T> buf_mat{ mat, sycl::range<2>{ dim, dim } };
 
   auto evt = q.submit([&](sycl::handler& h) {
-    global_2d_writer acc_mat{ buf_mat, h, sycl::no_init };
+    global_2d_writer_t<T> acc_mat{ buf_mat, h, sycl::no_init };
 
     h.parallel_for(
       sycl::nd_range<2>{ sycl::range<2>{ dim, dim }, sycl::range<2>{ 1, 32 } },
@@ -147,8 +149,51 @@ generate_hilbert_matrix(sycl::queue& q, float* const mat, const uint dim)
         const size_t r = it.get_global_id(0);
         const size_t c = it.get_global_id(1);
 
-        acc_mat[r][c] = 1.f / (float)(r + c + 1);
+        acc_mat[r][c] = T(1) / (T)(r + c + 1);
       });
   });
   evt.wait();
 }
+
+template void
+generate_random_vector<float>(float* const vec, const uint dim);
+
+template void
+generate_random_vector<double>(double* const vec, const uint dim);
+
+template void
+generate_hilbert_matrix<float>(sycl::queue& q,
+                               float* const mat,
+                               const uint dim);
+
+template void
+generate_hilbert_matrix<double>(sycl::queue& q,
+                                double* const mat,
+                                const uint dim);
+
+void
+generate_random_sparse_matrix(uint* const row_ptr,
+                              uint* const col_idx,
+                              float* const vals,
+                              const uint dim,
+                              const uint nnz_per_row)
+{
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<uint> col_dis(0, dim - 1);
+  std::uniform_real_distribution<float> val_dis(0.f, 1.f);
+
+  // diagonal is always present, so that each row has non-zero sum
+  for (uint i = 0; i < dim; i++) {
+    *(row_ptr + i) = i * nnz_per_row;
+
+    *(col_idx + i * nnz_per_row) = i;
+    *(vals + i * nnz_per_row) = 1.f;
+
+    for (uint j = 1; j < nnz_per_row; j++) {
+      *(col_idx + i * nnz_per_row + j) = col_dis(gen);
+      *(vals + i * nnz_per_row + j) = val_dis(gen);
+    }
+  }
+  *(row_ptr + dim) = dim * nnz_per_row;
+}
@@ -0,0 +1,29 @@
+#include "native_similarity_transform.hpp"
+
+// C API of native backend, built into its own shared object ( see `make
+// native` ), which doesn't link against SYCL runtime
+extern "C" int64_t
+native_max_eigen_value(const float* mat,
+                       float* eigen_val,
+                       float* eigen_vec,
+                       uint dim,
+                       uint* iter_cnt)
+{
+  return native_similarity_transform(mat, eigen_val, eigen_vec, dim, iter_cnt);
+}
+
+extern "C" int64_t
+native_max_eigen_value_f64(const double* mat,
+                           double* eigen_val,
+                           double* eigen_vec,
+                           uint dim,
+                           uint* iter_cnt)
+{
+  return native_similarity_transform(mat, eigen_val, eigen_vec, dim, iter_cnt);
+}
+
+extern "C" const char*
+native_isa()
+{
+  return native_simd_isa();
+}
@@ -11,39 +11,97 @@
 from typing import Tuple
 import numpy as np
 import ctypes
+import threading
 from genericpath import exists
 from posixpath import abspath
 
 
 class EigenValue:
     so_path: str = '../libsimilarity_transform.so'
-    sycl_q: ctypes.c_void_p = None
     so_lib: ctypes.CDLL = None
 
-    def __init__(self) -> None:
+    def __init__(self, max_dim: int = 1 << 12, slots: int = 2) -> None:
         '''
         Creates an instance of `EigenValue` class, along with backend resource(s)
-        like setting up SYCL queue where compute jobs will be submitted, getting
-        shared library ready for forwarding future function invocations
+        i.e. solver pool(s) owning `slots` SYCL queues, each with preallocated
+        device workspace for matrices of dimension upto `max_dim`, which are
+        reused by all later solves
+
+        Function signatures are declared only once, here, so that calls don't
+        pay for it; also as shared object is loaded using `ctypes.CDLL`, GIL is
+        released while solve is in progress, so solves issued from different
+        Python threads overlap, upto `slots` many at a time
         '''
         if not exists(self.so_path):
             raise Exception(
                 f'failed to find shared library `{abspath(self.so_path)}`')
 
         self.so_lib = ctypes.CDLL(self.so_path)
-
-        self.so_lib.make_queue.argtypes = [ctypes.POINTER(ctypes.c_void_p)]
-        self.sycl_q = ctypes.c_void_p()
-        self.so_lib.make_queue(ctypes.byref(self.sycl_q))
-
-        if self.sycl_q.value == None:
-            raise Exception(f'failed to get default SYCL queue')
-
-    def similarity_transform(self, mat: np.ndarray) -> Tuple[np.float32, np.ndarray, int, int]:
+        self.max_dim = max_dim
+        self.slots = slots
+
+        c_uint_p = ctypes.POINTER(ctypes.c_uint)
+        make_pool_t = [ctypes.c_uint, ctypes.c_uint,
+                       ctypes.POINTER(ctypes.c_void_p)]
+        solve_t = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+                   ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint, c_uint_p]
+
+        for make in ['make_pool', 'make_pool_f64']:
+            getattr(self.so_lib, make).argtypes = make_pool_t
+            getattr(self.so_lib, make).restype = None
+
+        for free in ['free_pool', 'free_pool_f64']:
+            getattr(self.so_lib, free).argtypes = [ctypes.c_void_p]
+            getattr(self.so_lib, free).restype = None
+
+        for solve in ['pool_solve_f32', 'pool_solve_f64']:
+            getattr(self.so_lib, solve).argtypes = solve_t
+            getattr(self.so_lib, solve).restype = ctypes.c_int64
+
+        batched_t = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+                     ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint,
+                     ctypes.c_void_p]
+
+        for solve in ['pool_solve_batched_f32', 'pool_solve_batched_f64']:
+            getattr(self.so_lib, solve).argtypes = batched_t
+            getattr(self.so_lib, solve).restype = ctypes.c_int64
+
+        # one pool per element type; float32 one is created right away, so
+        # that bad `max_dim`/ `slots` show up here & first solve doesn't pay
+        # for it, while float64 one is created on first use
+        self.pools = {}
+        self.lock = threading.Lock()
+        self._pool(np.float32)
+
+    def __del__(self) -> None:
+        for dtype, pool in getattr(self, 'pools', {}).items():
+            free = 'free_pool' if dtype == np.float32 else 'free_pool_f64'
+            getattr(self.so_lib, free)(pool)
+
+    def _pool(self, dtype: np.dtype) -> ctypes.c_void_p:
+        with self.lock:
+            if dtype not in self.pools:
+                make = 'make_pool' if dtype == np.float32 else 'make_pool_f64'
+                pool = ctypes.c_void_p()
+                getattr(self.so_lib, make)(
+                    self.slots, self.max_dim, ctypes.byref(pool))
+
+                if pool.value is None:
+                    raise Exception(f'failed to create solver pool')
+
+                self.pools[dtype] = pool
+
+            return self.pools[dtype]
+
+    def similarity_transform(self, mat: np.ndarray) -> Tuple[np.floating, np.ndarray, int, int]:
         '''
         Applies similarity transform method on provided
         square matrix ( represented as numpy array ) of
-        single precision floating point numbers
+        single or double precision floating point numbers
+
+        Both C ( row major ) and Fortran ( column major ) ordered
+        arrays are passed to backend as they're, without any copy;
+        only non-contiguous ones ( say strided views ) are copied
 
         Returns (max eigen value, respective eigen vector,
         time spent in milliseconds, iteration count before convergence)
@@ -51,28 +109,77 @@ class EigenValue:
         Assuming max eigen value = λ; eigen vector = v; input matrix = A
 
         then  Av = λv, must be satisfied !
+
+        Raises ValueError, when matrix isn't square, of float32/ float64
+        or larger than `max_dim` of pool
+        '''
+        if mat.ndim != 2 or mat.shape[0] != mat.shape[1]:
+            raise ValueError("must be square matrix of floating points !")
+        if mat.dtype not in (np.float32, np.float64):
+            raise ValueError("dtype of input matrix must be float32/ float64 !")
+        n = mat.shape[1]
+        if n > self.max_dim:
+            raise ValueError(f"matrix dimension must be <= {self.max_dim} !")
+
+        col_major = 0
+        if not mat.flags['C_CONTIGUOUS']:
+            if mat.flags['F_CONTIGUOUS']:
+                col_major = 1
+            else:
+                mat = np.ascontiguousarray(mat)
+
+        dtype = mat.dtype.type
+        solve = 'pool_solve_f32' if dtype == np.float32 else 'pool_solve_f64'
+
+        eigen_val = np.empty(1, dtype=dtype)
+        eigen_vec = np.empty(n, dtype=dtype)
+        iter_cnt = ctypes.c_uint(0)
+
+        ts = getattr(self.so_lib, solve)(
+            self._pool(dtype), mat.ctypes.data, eigen_val.ctypes.data,
+            eigen_vec.ctypes.data, n, col_major, ctypes.byref(iter_cnt))
+
+        return eigen_val[0], eigen_vec, ts, iter_cnt.value
+
+    def similarity_transform_batched(self, mats: np.ndarray) -> Tuple[np.ndarray, np.ndarray, int, np.ndarray]:
+        '''
+        Applies similarity transform method on each of N square matrices
+        of shape d x d, stacked in one array of shape (N, d, d), all of them
+        being solved in a single device submission, so that cost of crossing
+        Python/ C++ boundary & synchronizing with device is paid only once,
+        for whole stack
+
+        Stack must be C ordered ( it's copied otherwise ), while `d` is
+        bounded by `max_dim` of pool, same as in `similarity_transform`
+
+        Returns (max eigen values of shape (N,), respective eigen vectors
+        of shape (N, d), time spent in milliseconds, iteration counts of
+        shape (N,))
         '''
-        m, n = mat.shape
-        assert m == n, "must be square matrix of floating points !"
-        assert mat.dtype.num == 11, "dtype of input matrix must be float32 !"
-
-        mat_t = np.ctypeslib.ndpointer(
-            dtype=np.float32, ndim=2, flags='CONTIGUOUS')
-        vec_t = np.ctypeslib.ndpointer(
-            dtype=np.float32, ndim=1, flags='CONTIGUOUS')
-        itr_cnt_t = np.ctypeslib.ndpointer(
-            dtype=np.uint, ndim=1, flags='CONTIGUOUS')
-
-        self.so_lib.max_eigen_value.restype = ctypes.c_int64
-        self.so_lib.max_eigen_value.argtypes = [
-            ctypes.c_void_p,
-            mat_t, vec_t, vec_t, ctypes.c_uint, itr_cnt_t]
-
-        eigen_val = np.empty(1, dtype=np.float32)
-        eigen_vec = np.empty(n, dtype=np.float32)
-        iter_cnt = np.zeros(1, dtype=np.uint)
-
-        ts = self.so_lib.max_eigen_value(
-            self.sycl_q, mat, eigen_val, eigen_vec, n, iter_cnt)
-
-        return eigen_val[0], eigen_vec, ts, iter_cnt[0]
+        if mats.ndim != 3:
+            raise ValueError("must be stack of matrices, shaped (N, d, d) !")
+        b, m, n = mats.shape
+        if m != n:
+            raise ValueError("must be stack of square matrices of floating points !")
+        if mats.dtype not in (np.float32, np.float64):
+            raise ValueError("dtype of input matrices must be float32/ float64 !")
+        if n > self.max_dim:
+            raise ValueError(f"matrix dimension must be <= {self.max_dim} !")
+
+        mats = np.ascontiguousarray(mats)
+
+        dtype = mats.dtype.type
+        solve = 'pool_solve_batched_f32' if dtype == np.float32 else 'pool_solve_batched_f64'
+
+        eigen_vals = np.empty(b, dtype=dtype)
+        eigen_vecs = np.empty((b, n), dtype=dtype)
+        iter_cnts = np.empty(b, dtype=np.uint32)
+
+        if b == 0:
+            return eigen_vals, eigen_vecs, 0, iter_cnts
+
+        ts = getattr(self.so_lib, solve)(
+            self._pool(dtype), mats.ctypes.data, eigen_vals.ctypes.data,
+            eigen_vecs.ctypes.data, b, n, iter_cnts.ctypes.data)
+
+        return eigen_vals, eigen_vecs, ts, iter_cnts
@@ -1,21 +1,62 @@
 import similarity_transform as st
+from concurrent.futures import ThreadPoolExecutor
 
 N = 1 << 2  # test rounds
 DIM = 1 << 10  # test square matrix dimension
-TOL = 1e-3  # absoluate error tolerance in floating point math
+TOL = {st.np.float32: 1e-3, st.np.float64: 1e-6}  # absolute error tolerance
+
+
+def check(mat, λ, v):
+    tol = TOL[mat.dtype.type]
+    assert st.np.all(st.np.isclose(st.np.matmul(mat, v), λ * v,
+                                   atol=tol)), "Av = λv assertion failed !"
 
 
 def main():
-    ev = st.EigenValue()  # prepare sycl queue & shared object to be interacted with
-    mat = st.np.random.random((DIM, DIM)).astype(
-        'f')  # converting dtype to float32
-    for i in range(N):
-        λ, v, ts, itr = ev.similarity_transform(mat)
-
-        assert st.np.all(st.np.isclose(st.np.matmul(mat, v), λ * v,
-                                       atol=TOL)), "Av = λv assertion failed !"
+    # prepare solver pool(s) & shared object to be interacted with
+    ev = st.EigenValue(max_dim=DIM)
+    mat = st.np.random.random((DIM, DIM))
+
+    for dtype in [st.np.float32, st.np.float64]:
+        for order in ['C', 'F']:
+            m = st.np.asarray(mat, dtype=dtype, order=order)
+
+            for i in range(N):
+                λ, v, ts, itr = ev.similarity_transform(m)
+                check(m, λ, v)
+                print(
+                    f'{i:>3} passed randomized test against {DIM} x {DIM} {m.dtype} ( {order} order ) similarity transform\tin {ts:8} ms\twith {itr} round(s)')
+
+    # stack of small matrices, solved at once
+    mats = st.np.random.random((N << 8, 16, 16))
+    for dtype in [st.np.float32, st.np.float64]:
+        ms = mats.astype(dtype)
+        λs, vs, ts, itrs = ev.similarity_transform_batched(ms)
+        assert λs.shape == (ms.shape[0],) and vs.shape == ms.shape[:2]
+        for m, λ, v in zip(ms, λs, vs):
+            check(m, λ, v)
         print(
-            f'{i:>3} passed randomized test against {DIM} x {DIM} similarity transform\tin {ts:8} ms\twith {itr} round(s)')
+            f'passed randomized test against {ms.shape[0]} x 16 x 16 {ms.dtype} batched similarity transform\tin {ts:8} ms\twith upto {itrs.max()} round(s)')
+
+    # solves issued from multiple threads, overlapping each other
+    m = mat.astype('f')
+    with ThreadPoolExecutor(max_workers=ev.slots * 2) as pool:
+        for λ, v, ts, itr in pool.map(ev.similarity_transform, [m] * N * 2):
+            check(m, λ, v)
+    print(f'passed {N * 2} concurrent solves from {ev.slots * 2} threads')
+
+    # matrices larger than pool was created for are refused, not solved
+    for big in [st.np.zeros((DIM + 1, DIM + 1), dtype='f'),
+                st.np.zeros((1, DIM + 1, DIM + 1), dtype='f')]:
+        try:
+            if big.ndim == 2:
+                ev.similarity_transform(big)
+            else:
+                ev.similarity_transform_batched(big)
+        except ValueError:
+            continue
+        raise AssertionError(f'{big.shape} matrix must be refused !')
+    print(f'passed refusing matrices larger than {DIM} x {DIM}')
 
 
 if __name__ == '__main__':
@@ -1,4 +1,7 @@
+#include "autotune.hpp"
+#include "eigen_solver.hpp"
 #include "similarity_transform.hpp"
+#include "solver_pool.hpp"
 
 extern "C" void
 make_queue(void** wq)
@@ -21,17 +24,217 @@ max_eigen_value(void* wq,
 {
   sycl::queue* q = reinterpret_cast<sycl::queue*>(wq);
 
-  const size_t max_wg_size =
-    q->get_device().get_info<sycl::info::device::max_work_group_size>();
-
+  // work-group size & engine are chosen by autotuner, first call for
+  // some device/ dimension bucket may take a while
   int64_t ts =
-    similarity_transform(*q,
-                         mat,
-                         eigen_val,
-                         eigen_vec,
-                         dim,
-                         (dim >> 1) > max_wg_size ? max_wg_size : (dim >> 1),
-                         iter_cnt);
+    similarity_transform(*q, mat, eigen_val, eigen_vec, dim, iter_cnt);
+
+  return ts;
+}
+
+extern "C" void
+make_solver(void* wq, uint max_dim, void** ws)
+{
+  sycl::queue* q = reinterpret_cast<sycl::queue*>(wq);
+  EigenSolver<float>* solver = new EigenSolver<float>{ *q, max_dim };
+
+  *ws = solver;
+}
+
+extern "C" void
+free_solver(void* ws)
+{
+  EigenSolver<float>* solver = reinterpret_cast<EigenSolver<float>*>(ws);
+  delete solver;
+}
+
+extern "C" int64_t
+solver_max_eigen_value(void* ws,
+                       float* mat,
+                       float* eigen_val,
+                       float* eigen_vec,
+                       uint dim,
+                       uint* iter_cnt)
+{
+  EigenSolver<float>* solver = reinterpret_cast<EigenSolver<float>*>(ws);
+  if (dim > solver->max_dim()) {
+    return -1;
+  }
+
+  int64_t ts = 0;
+  if (small_similarity_transform(
+        mat, eigen_val, eigen_vec, dim, layout_t::row_major, iter_cnt, &ts)) {
+    return ts / 1000;
+  }
+
+  // solver always uses implicit scaling, so only tuned work-group
+  // size is of interest here
+  const tuned_config cfg = autotune<float>(solver->queue(), dim);
+
+  ts = solver->solve(mat, eigen_val, eigen_vec, dim, cfg.wg_size, iter_cnt);
 
   return ts;
 }
+
+// Pool of `slots` solvers ( each one with its own queue & workspace for
+// matrices upto `max_dim` ), on default device, which can be used from any
+// number of threads at once, unlike queue/ solver above; `*wp` is set to
+// null, when `slots` is 0
+extern "C" void
+make_pool(uint slots, uint max_dim, void** wp)
+{
+  // pool without slots can't solve anything, so none is made
+  if (slots == 0) {
+    *wp = nullptr;
+    return;
+  }
+
+  sycl::default_selector d_sel{};
+  sycl::device d{ d_sel };
+  SolverPool<float>* pool = new SolverPool<float>{ d, slots, max_dim };
+
+  *wp = pool;
+}
+
+extern "C" void
+free_pool(void* wp)
+{
+  SolverPool<float>* pool = reinterpret_cast<SolverPool<float>*>(wp);
+  delete pool;
+}
+
+// Thread-safe; blocks calling thread until solve completes on some free slot
+extern "C" int64_t
+pool_max_eigen_value(void* wp,
+                     float* mat,
+                     float* eigen_val,
+                     float* eigen_vec,
+                     uint dim,
+                     uint* iter_cnt)
+{
+  SolverPool<float>* pool = reinterpret_cast<SolverPool<float>*>(wp);
+  if (dim > pool->max_dim()) {
+    return -1;
+  }
+
+  return pool->solve(mat, eigen_val, eigen_vec, dim, iter_cnt);
+}
+
+// Snapshot of pool statistics, where `utilization` must have room for as
+// many slots as pool was created with
+extern "C" void
+pool_stats(void* wp,
+           uint* queue_depth,
+           uint* in_flight,
+           uint64_t* completed,
+           double* utilization)
+{
+  SolverPool<float>* pool = reinterpret_cast<SolverPool<float>*>(wp);
+
+  *queue_depth = pool->queue_depth();
+  *in_flight = pool->in_flight();
+  *completed = pool->completed();
+  pool->utilization(utilization);
+}
+
+extern "C" void
+make_pool_f64(uint slots, uint max_dim, void** wp)
+{
+  if (slots == 0) {
+    *wp = nullptr;
+    return;
+  }
+
+  sycl::default_selector d_sel{};
+  sycl::device d{ d_sel };
+  SolverPool<double>* pool = new SolverPool<double>{ d, slots, max_dim };
+
+  *wp = pool;
+}
+
+extern "C" void
+free_pool_f64(void* wp)
+{
+  SolverPool<double>* pool = reinterpret_cast<SolverPool<double>*>(wp);
+  delete pool;
+}
+
+// Same as `pool_max_eigen_value`, but matrix can also be column major
+// ( `col_major` != 0 ), which is transposed in device memory, so that
+// caller doesn't need to make row major copy of it
+extern "C" int64_t
+pool_solve_f32(void* wp,
+               const float* mat,
+               float* eigen_val,
+               float* eigen_vec,
+               uint dim,
+               uint col_major,
+               uint* iter_cnt)
+{
+  SolverPool<float>* pool = reinterpret_cast<SolverPool<float>*>(wp);
+  if (dim > pool->max_dim()) {
+    return -1;
+  }
+
+  const layout_t layout = col_major ? layout_t::col_major : layout_t::row_major;
+
+  return pool->solve(mat, eigen_val, eigen_vec, dim, layout, iter_cnt);
+}
+
+extern "C" int64_t
+pool_solve_f64(void* wp,
+               const double* mat,
+               double* eigen_val,
+               double* eigen_vec,
+               uint dim,
+               uint col_major,
+               uint* iter_cnt)
+{
+  SolverPool<double>* pool = reinterpret_cast<SolverPool<double>*>(wp);
+  if (dim > pool->max_dim()) {
+    return -1;
+  }
+
+  const layout_t layout = col_major ? layout_t::col_major : layout_t::row_major;
+
+  return pool->solve(mat, eigen_val, eigen_vec, dim, layout, iter_cnt);
+}
+
+// Solves `batch` many row major dim x dim matrices, laid out one after
+// another in `mats`, in a single device submission; `eigen_vecs` must have
+// room for `batch` x `dim` elements
+extern "C" int64_t
+pool_solve_batched_f32(void* wp,
+                       const float* mats,
+                       float* eigen_vals,
+                       float* eigen_vecs,
+                       uint batch,
+                       uint dim,
+                       uint* iter_cnts)
+{
+  SolverPool<float>* pool = reinterpret_cast<SolverPool<float>*>(wp);
+  if (dim > pool->max_dim()) {
+    return -1;
+  }
+
+  return pool->solve_batched(
+    mats, eigen_vals, eigen_vecs, batch, dim, iter_cnts);
+}
+
+extern "C" int64_t
+pool_solve_batched_f64(void* wp,
+                       const double* mats,
+                       double* eigen_vals,
+                       double* eigen_vecs,
+                       uint batch,
+                       uint dim,
+                       uint* iter_cnts)
+{
+  SolverPool<double>* pool = reinterpret_cast<SolverPool<double>*>(wp);
+  if (dim > pool->max_dim()) {
+    return -1;
+  }
+
+  return pool->solve_batched(
+    mats, eigen_vals, eigen_vecs, batch, dim, iter_cnts);
+}